@@ -1,3145 +1,7154 @@
-/*////////////////////////////////////////////////////
-// Public domain, vector-graphics library.
-//////////////////////////////////////////////////////
-
-CREATOR: Josian Marriott (josianjames@gmail.com)
-
-LICENSE: This software is dual-licensed to the public domain and under the following
-license: you are granted a perpetual, irrevocable license to copy, modify,
-publish, and distribute this file as you see fit.
-
-////////////////////////////////////////////////////*/
-
-#ifndef VGL_H
-#define VGL_H
-
-#ifndef VGL_API
-#define VGL_API extern
-#endif
-
-/*//////////////////////////
-// DRIVER
-//////////////////////////*/
-
-#define VGL_OPENGL  (1)
-#define VGL_VULKAN  (2) // not implemented
-#define VGL_DIRECTX (3) // not implemented
-
-#ifndef VGL_DRIVER
-#define VGL_DRIVER VGL_OPENGL
-#endif
-
-/*//////////////////////////
-// API
-//////////////////////////*/
-
-#define VG_NEGATIVE     (-1)
-#define VG_POSITIVE     (1)
-#define VG_NONZERO      (2)
-#define VG_EVENODD      (3)
-#define VG_INTERSECTION (4)
-
-typedef unsigned vgColor;
-typedef struct   vgPoint  vgPoint;
-typedef union    vgMatrix vgMatrix;
-typedef struct   vgFont   vgFont;
-
-VGL_API void  vg_init       ();
-VGL_API void  vg_begin      ();
-VGL_API void  vg_flush      ();
-VGL_API void  vg_clear      (unsigned color);
-VGL_API void  vg_end        ();
-
-VGL_API void  vg_path       ();
-VGL_API void  vg_moveto     (float x, float y);
-VGL_API void  vg_lineto     (float x, float y);
-VGL_API void  vg_curveto    (float x0, float y0, float x1, float y1);
-VGL_API void  vg_cubicto    (float x0, float y0, float x1, float y1, float x2, float y2);
-VGL_API void  vg_arcto      (float x0, float y0, float x1, float y1, float radius);
-VGL_API void  vg_line       (float x0, float y0, float x1, float y1);
-VGL_API void  vg_vline      (float x, float y0, float y1);
-VGL_API void  vg_hline      (float y, float x0, float x1);
-VGL_API void  vg_arc        (float x, float y, float a0, float a1, float r);
-VGL_API void  vg_circle     (float x, float y, float r);
-VGL_API void  vg_ellipse    (float x, float y, float rx, float ry);
-VGL_API void  vg_rect       (float x, float y, float w, float h);
-VGL_API void  vg_rectr      (float x, float y, float w, float h, float rx, float ry);
-VGL_API void  vg_char       (float x, float y, float size, int c);
-VGL_API void  vg_text       (float x, float y, float size, const char *str);
-VGL_API void  vg_textn      (float x, float y, float size, const char *str, const char *end);
-VGL_API void  vg_textf      (float x, float y, float size, const char *format, ...);
-VGL_API float vg_textw      (float size, const char *str, const char *end);
-VGL_API void  vg_close      ();
-
-VGL_API void  vg_fill       (unsigned color);
-VGL_API void  vg_fillr      (unsigned c0, unsigned c1, float x, float y, float r0, float r1);
-VGL_API void  vg_fillb      (unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1);
-VGL_API void  vg_fillg      (unsigned c0, unsigned c1, float x0, float y0, float x1, float y1);
-VGL_API void  vg_fillgr     (unsigned c0, unsigned c1, float x, float y, float w, float h, float r);
-VGL_API void  vg_fillbh     (float x, float y, float w, float h, float sat, float val);
-VGL_API void  vg_fillbs     (float x, float y, float w, float h, float hue);
-VGL_API void  vg_stroke     (unsigned color, float width);
-
-VGL_API void  vg_push       ();
-VGL_API void  vg_reset      ();
-VGL_API void  vg_mode       (int mode);
-VGL_API void  vg_winding    (int winding);
-VGL_API void  vg_spaa       (float spaa);
-VGL_API void  vg_alpha      (float alpha);
-VGL_API void  vg_font       (vgFont *font);
-VGL_API void  vg_matrix     (float *matrix);
-VGL_API void  vg_identity   ();
-VGL_API void  vg_translate  (float x, float y);
-VGL_API void  vg_rotate     (float degs);
-VGL_API void  vg_rotater    (float rads);
-VGL_API void  vg_scale      (float x, float y);
-VGL_API void  vg_project    (float *x, float *y);
-VGL_API void  vg_unproject  (float *x, float *y);
-VGL_API void  vg_projectn   (float *x, float *y);
-VGL_API void  vg_unprojectn (float *x, float *y);
-VGL_API void  vg_clip       (float x, float y, float w, float h);
-VGL_API void  vg_noclip     ();
-VGL_API void  vg_pop();
-
-VGL_API void  vg_size       (int *w, int *h);
-
-/*//////////////////////////
-// MATH
-//////////////////////////*/
-
-#define VG_PI  (3.14159265358979323846f)
-#define VG_PI2 (VG_PI*2.0f)
-#define VG_RAD (VG_PI/180.0f)
-#define VG_DEG (180.0f/VG_PI)
-
-/*//////////////////////////
-// POINT
-//////////////////////////*/
-
-struct vgPoint {
-	float x, y;
-};
-
-int vg_point_norm(vgPoint *v, float *l);
-
-/*//////////////////////////
-// MATRIX
-//////////////////////////*/
-
-union vgMatrix {
-	float v[6];
-	float m[3][3];
-	struct {
-		float xx, xy, xt;
-		float yx, yy, yt;
-	};
-};
-
-VGL_API void vg_matrix_identity   (float *m);
-VGL_API void vg_matrix_translate  (float *m, float x, float y);
-VGL_API void vg_matrix_rotate     (float *m, float a);
-VGL_API void vg_matrix_scale      (float *m, float x, float y);
-VGL_API void vg_matrix_multiply   (float *m, float *mul);
-VGL_API int  vg_matrix_inverse    (float *m, float *src);
-VGL_API void vg_matrix_lerp       (float *m, float *mat, float t);
-VGL_API void vg_matrix_project    (float *m, float *x, float *y);
-VGL_API void vg_matrix_unproject  (float *m, float *x, float *y);
-VGL_API void vg_matrix_projectn   (float *m, float *x, float *y);
-VGL_API void vg_matrix_unprojectn (float *m, float *x, float *y);
-VGL_API void vg_matrix_pan        (float *m, float x, float y, float speed);
-VGL_API void vg_matrix_zoom       (float *m, float x, float y, float zoom);
-
-/*//////////////////////////
-// COLOR
-//////////////////////////*/
-
-#define VG_R(c)                   (((c) >>  0) & 0xFF)
-#define VG_G(c)                   (((c) >>  8) & 0xFF)
-#define VG_B(c)                   (((c) >> 16) & 0xFF)
-#define VG_A(c)                   (((c) >> 24) & 0xFF)
-#define VG_RGBA(r, g, b, a)       ((vgColor)((r) | (g) << 8 | (b) << 16 | (a) << 24))
-#define VG_RGB(r, g, b)           VG_RGBA((r), (g), (b), 0xFF)
-#define VG_RGBAF(r, g, b, a)      VG_RGBA((vgColor)(r*0xFF),(vgColor)(g*0xFF),(vgColor)(b*0xFF),(vgColor)(a*0xFF))
-#define VG_RGBF(r, g, b)          VG_RGBA((vgColor)(r*0xFF),(vgColor)(g*0xFF),(vgColor)(b*0xFF),0xFF)
-#define VG_ALPHA(c, a)            ((vgColor)((c & 0x00FFFFFF) | ((VG_A(c) * (a) / 0xFF) << 24)))
-#define VG_ALPHAF(c, a)           VG_ALPHA(c, (vgColor)(a*0xFF))
-#define VG_HSV(h, s, v)           vg_color_hsv((h), (s), (v))
-#define VG_BLEND(src, dst)        vg_color_blend(src, dst)
-#define VG_LERP(src, dst, a)      vg_color_lerp(src, dst, a)
-#define VG_LERPF(src, dst, a)     vg_color_lerpf(src, dst, a)
-
-VGL_API vgColor vg_color_hsv   (float h, float s, float v);
-VGL_API vgColor vg_color_blend (vgColor src, vgColor dst);
-VGL_API vgColor vg_color_lerp  (vgColor src, vgColor dst, vgColor a);
-VGL_API vgColor vg_color_lerpf (vgColor src, vgColor dst, float a);
-
-/*//////////////////////////
-// FONT
-//////////////////////////*/
-
-VGL_API vgFont* vg_font_load         (const char *filename);
-VGL_API vgFont* vg_font_loadp        (void *data, int size);
-VGL_API vgFont* vg_font_default      ();
-VGL_API void    vg_font_draw_char    (vgFont *font, float x, float y, float size, int c);
-VGL_API void    vg_font_draw_text    (vgFont *font, float x, float y, float size, const char *str, const char *end);
-VGL_API float   vg_font_measure_text (vgFont *font, float size, const char *str, const char *end);
-
-/*//////////////////////////
-// COMMANDS
-//////////////////////////*/
-
-enum {
-	VG_CMD_END     = 0,
-	VG_CMD_MOVETO  = 1,
-	VG_CMD_LINETO  = 2,
-	VG_CMD_CURVETO = 3,
-	VG_CMD_CUBICTO = 4,
-	VG_CMD_ALPHA   = 5,
-	VG_CMD_FILL    = 6,
-	VG_CMD_STROKE  = 7,
-	// TODO: extend
-};
-
-typedef union vgCommand {
-	unsigned char type;
-	struct { unsigned char type; float coords[2];            } moveto;
-	struct { unsigned char type; float coords[2];            } lineto;
-	struct { unsigned char type; float coords[4];            } curveto;
-	struct { unsigned char type; float coords[6];            } cubicto;
-	struct { unsigned char type; float value;                } alpha;
-	struct { unsigned char type; vgColor color;              } fill;
-	struct { unsigned char type; vgColor color; float width; } stroke;
-} vgCommand;
-
-void vg_eval(vgCommand *commands);
-
-/*//////////////////////////
-// IMPLEMENTATION
-//////////////////////////*/
-
-#if defined(VGL_IMPLEMENTATION) || defined(__INTELLISENSE__)
-
-#include <stdlib.h>
-#include <stdarg.h>
-#include <stdio.h>
-#include <assert.h>
-#include <string.h>
-#include <math.h>
-
-#define VG_MAX_PATH    (2048*2048)
-#define VG_MAX_STATE   (256)
-
-#define VG_TESS_DIST   (4.0f)
-#define VG_TESS_DIST2  (VG_TESS_DIST*VG_TESS_DIST)
-#define VG_TESS_FACTOR (1.0f / VG_TESS_DIST)
-
-typedef union  vgPath    vgPath;
-typedef struct vgState   vgState;
-typedef struct vgContext vgContext;
-
-union vgPath {
-	struct {
-		int closed   : 1;
-		int winding  : 1;
-		int reserved : 30;
-		int end;
-	};
-	vgPoint point;
-};
-
-struct vgState {
-	int      mode;
-	int      winding;
-	float    spaa;
-	float    alpha;
-	vgFont*  font;
-	vgMatrix matrix;
-	vgMatrix clip;
-};
-
-struct vgContext {
-	struct {
-		int x;
-		int y;
-	} size;
-	struct {
-		int edges;
-		int tiles;
-		int draws;
-		int upload;
-	} stats;
-	vgState state;
-};
-
-vgContext vg;
-int       vg_initialized;
-int       vg_path_reset;
-int       vg_path_index;
-int       vg_path_count;
-vgPoint   vg_path_start;
-vgPoint   vg_path_point;
-vgPath    vg_path_buffer[VG_MAX_PATH];
-vgState   vg_state_buffer[VG_MAX_STATE];
-int       vg_state_count;
-void     *vg_default_font;
-
-static void vg_fill_prime();
-static void vg_fill_flush();
-
-void vg_driver_init();
-void vg_driver_prime();
-void vg_driver_size(int *w, int *h);
-void vg_driver_clear(unsigned color);
-void vg_driver_flush();
-
-void vg_init()
-{
-	if (vg_initialized) return;
-	vg_initialized = 1;
-	memset(&vg, 0, sizeof(vg));
-	vg_driver_init();
-	vg.state.spaa = 0;
-	vg_reset();
-}
-
-void vg_begin()
-{
-	int w, h;
-
-	vg_init();
-
-	vg_driver_size(&w, &h);
-	vg.size.x = w;
-	vg.size.y = h;
-
-	vg.stats.edges  = 0;
-	vg.stats.tiles  = 0;
-	vg.stats.draws  = 0;
-	vg.stats.upload = 0;
-
-	vg_path_reset  = 1;
-	vg_path_index  = 0;
-	vg_path_count  = 0;
-	vg_state_count = 0;
-
-	vg_reset();
-	vg_fill_prime();
-	vg_driver_prime();
-}
-
-void vg_size(int *w, int *h)
-{
-	*w = vg.size.x;
-	*h = vg.size.y;
-}
-
-void vg_path()
-{
-	if (!vg_path_reset) return;
-	vg_path_reset = 0;
-	vg_path_index = 0;
-	vg_path_count = 0;
-}
-
-void vg_end()
-{
-	vg_flush();
-}
-
-void vg_clear(unsigned color)
-{
-	vg_driver_clear(color);
-}
-
-void vg_flush()
-{
-	vg_driver_flush();
-	vg_fill_flush();
-}
-
-static void vg_push_point(float x, float y)
-{
-	assert(vg_path_count < VG_MAX_PATH - 1);
-	vgPoint point = { x, y };
-	vg_path();
-	if (vg_path_index == vg_path_count) {
-		vgPath *path = &vg_path_buffer[vg_path_count++];
-		path->winding = vg.state.winding >= 0;
-		vg_path_start = point;
-	}
-	vg_path_point = point;
-	vg_path_buffer[vg_path_count++].point = (vgPoint) { x, y };
-}
-
-static void vg_push_path()
-{
-	if (vg_path_index == vg_path_count) return;
-	vgPath *path = &vg_path_buffer[vg_path_index];
-	path->end = vg_path_count;
-	path->closed = vg_path_point.x == vg_path_start.x && vg_path_point.y == vg_path_start.y;
-	vg_path_index = vg_path_count;
-}
-
-void vg_moveto(float x, float y)
-{
-	vg_push_path();
-	vg_project(&x, &y);
-	vg_push_point(x, y);
-}
-
-void vg_lineto(float x, float y)
-{
-	vg_project(&x, &y);
-	vg_push_point(x, y);
-}
-
-static void vg_curvetor(
-	float x1, float y1,
-	float x2, float y2,
-	float x3, float y3,
-	int level)
-{
-	const float tesstol = 0.125f;
-
-	float x12, y12, x23, y23, x123, y123;
-	float dx, dy, d2;
-
-	if (level > 10) {
-		vg_push_point(x3, y3);
-		return;
-	}
-
-	dx = x3 - x1;
-	dy = y3 - y1;
-	d2 = ((x2 - x3) * dy - (y2 - y3) * dx);
-
-	if ((fabsf(dx) < 0.5f && fabsf(dy) < 0.5f)) {
-		vg_push_point(x3, y3);
-		return;
-	}
-
-	if (d2*d2 < tesstol * (dx*dx + dy*dy)) {
-		vg_push_point(x3, y3);
-		return;
-	}
-
-	x12 = (x1 + x2) * 0.5f;
-	y12 = (y1 + y2) * 0.5f;
-	x23 = (x2 + x3) * 0.5f;
-	y23 = (y2 + y3) * 0.5f;
-	x123 = (x12 + x23) * 0.5f;
-	y123 = (y12 + y23) * 0.5f;
-
-	vg_curvetor(x1, y1, x12, y12, x123, y123, level + 1);
-	vg_curvetor(x123, y123, x23, y23, x3, y3, level + 1);
-}
-
-void vg_curveto(float ax, float ay, float px, float py)
-{
-	float sx, sy;
-
-	if (vg_path_reset) {
-		vg_moveto(px, py);
-		return;
-	}
-
-	vg_project(&ax, &ay);
-	vg_project(&px, &py);
-
-	sx = vg_path_point.x;
-	sy = vg_path_point.y;
-
-	if ((sx < 0 && ax < 0 && px < 0) ||
-		(sx > vg.size.x && ax > vg.size.x && px > vg.size.x) ||
-		(sy < 0 && ax < 0 && px < 0) ||
-		(sy > vg.size.y && ay > vg.size.x && px > vg.size.x)) {
-		vg_push_point(ax, ay);
-		vg_push_point(px, py);
-		return;
-	}
-
-	vg_curvetor(sx, sy, ax, ay, px, py, 0);
-}
-
-static void vg_cubictor(
-	float x1, float y1,
-	float x2, float y2,
-	float x3, float y3,
-	float x4, float y4,
-	int level)
-{
-	// bezier tesselation. thanks to nanovg.
-	const float tesstol = 0.125f;
-
-	float x12, y12, x23, y23, x34, y34, x123, y123, x234, y234, x1234, y1234;
-	float dx, dy, d2, d3;
-
-	if (level > 10) {
-		vg_push_point(x4, y4);
-		return;
-	}
-
-	dx = x4 - x1;
-	dy = y4 - y1;
-	d2 = fabsf(((x2 - x4) * dy - (y2 - y4) * dx));
-	d3 = fabsf(((x3 - x4) * dy - (y3 - y4) * dx));
-
-	if ((fabsf(dx) < 0.5f && fabsf(dy) < 0.5f)) {
-		vg_push_point(x4, y4);
-		return;
-	}
-
-	if ((d2 + d3)*(d2 + d3) < tesstol * (dx*dx + dy*dy)) {
-		vg_push_point(x4, y4);
-		return;
-	}
-
-	x12   = (x1 + x2) * 0.5f;
-	y12   = (y1 + y2) * 0.5f;
-	x23   = (x2 + x3) * 0.5f;
-	y23   = (y2 + y3) * 0.5f;
-	x34   = (x3 + x4) * 0.5f;
-	y34   = (y3 + y4) * 0.5f;
-	x123  = (x12 + x23) * 0.5f;
-	y123  = (y12 + y23) * 0.5f;
-	x234  = (x23 + x34) * 0.5f;
-	y234  = (y23 + y34) * 0.5f;
-	x1234 = (x123 + x234) * 0.5f;
-	y1234 = (y123 + y234) * 0.5f;
-
-	vg_cubictor(x1, y1, x12, y12, x123, y123, x1234, y1234, level + 1);
-	vg_cubictor(x1234, y1234, x234, y234, x34, y34, x4, y4, level + 1);
-}
-
-void vg_cubicto(float ax, float ay, float bx, float by, float px, float py)
-{
-	float sx, sy;
-
-	if (vg_path_reset) {
-		vg_moveto(px, py);
-		return;
-	}
-
-	vg_project(&ax, &ay);
-	vg_project(&bx, &by);
-	vg_project(&px, &py);
-
-	sx = vg_path_point.x;
-	sy = vg_path_point.y;
-
-	if ((sx < 0 && ax < 0 && bx < 0 && px < 0) ||
-		(sx > vg.size.x && ax > vg.size.x && bx > vg.size.x && px > vg.size.x) ||
-		(sy < 0 && ay < 0 && by < 0 && py < 0) ||
-		(sy > vg.size.y && ay > vg.size.y && by > vg.size.y && py > vg.size.y)) {
-		vg_push_point(ax, ay);
-		vg_push_point(bx, by);
-		vg_push_point(px, py);
-		return;
-	}
-
-	vg_cubictor(sx, sy, ax, ay, bx, by, px, py, 0);
-}
-
-void vg_close()
-{
-	if (vg_path_point.x != vg_path_start.x ||
-		vg_path_point.y != vg_path_start.y) {
-		vg_push_point(vg_path_start.x, vg_path_start.y);
-	}
-}
-
-void vg_line(float x0, float y0, float x1, float y1)
-{
-	vg_moveto(x0, y0);
-	vg_lineto(x1, y1);
-}
-
-void vg_vline(float x, float y0, float y1)
-{
-	vg_moveto(x, y0);
-	vg_lineto(x, y1);
-}
-
-void vg_hline(float y, float x0, float x1)
-{
-	vg_moveto(x0, y);
-	vg_lineto(x1, y);
-}
-
-void vg_arc(float x, float y, float a0, float a1, float r)
-{
-	static int   cached;
-	static float points[2048][2];
-	const  int   cachesize = sizeof(points) / sizeof(points[0]);
-
-	if (!cached) {
-		float step = 3.14159265359f * 2.0f / cachesize;
-		float angle = 0.0f;
-		for (int index = 0; index < cachesize; index++) {
-			angle += step;
-			points[index][0] = cosf(angle);
-			points[index][1] = sinf(angle);
-		}
-		cached = 1;
-	}
-
-	float delta, start, angle, step, *vector, sx, sy;
-	int index, id, count, closed;
-
-	sx = vg.state.matrix.xx + vg.state.matrix.xy;
-	sy = vg.state.matrix.yx + vg.state.matrix.yy;
-
-	count = 4 + (int)(fabsf(r) * 0.75f * sqrtf(sx * sx + sy * sy));
-	if (count > 256) count = 256;
-
-	delta = a1 - a0;
-	delta = delta < -360.0f ? -360.0f : delta > 360.0f ? 360.0f : delta;
-	closed = delta == 360.0f;
-	step = 1.0f / (count - 1) * delta / 360.0f;
-	start = angle = a0 / 360.0f;
-	if (r < 0) step = -step;
-
-	for (index = 0; index < count; index++) {
-		id = ((int)(angle * cachesize) % cachesize + cachesize) % cachesize;
-		vector = points[id];
-		if (index == 0) {
-			vg_moveto(x + vector[0] * r, y + vector[1] * r);
-		} else {
-			vg_lineto(x + vector[0] * r, y + vector[1] * r);
-		}
-		if (closed && index == count - 2) {
-			angle = start;
-		} else {
-			angle += step;
-		}
-	}
-}
-
-void vg_ellipse(float x, float y, float rx, float ry)
-{
-	vgMatrix m;
-	m = vg.state.matrix;
-	vg_scale(rx, ry);
-	vg_arc(x, y, 0, 360, 1.0f);
-	vg.state.matrix = m;
-}
-
-void vg_circle(float x, float y, float r)
-{
-	vg_arc(x, y, 0, 360, r);
-}
-
-void vg_rect(float x, float y, float w, float h)
-{
-	vg_moveto(x, y);
-	vg_lineto(x + w, y);
-	vg_lineto(x + w, y + h);
-	vg_lineto(x, y + h);
-	vg_lineto(x, y);
-}
-
-void vg_rectr(float x, float y, float w, float h, float rx, float ry)
-{
-	float hw, hh;
-
-	hw = w * 0.5f;
-	hh = h * 0.5f;
-	rx = (rx > fabsf(hw)) ? hw : hw > 0 ? rx : -rx;
-	ry = (ry > fabsf(hh)) ? hh : hh > 0 ? ry : -ry;
-
-	vg_moveto  (x + rx,     y                                  );
-	vg_lineto  (x + w - rx, y                                  );
-	vg_curveto (x + w,      y,          x + w,      y + ry     );
-	vg_lineto  (x + w,      y + h - ry                         );
-	vg_curveto (x + w,      y + h,      x + w - rx, y + h      );
-	vg_lineto  (x + rx,     y + h                              );
-	vg_curveto (x,          y + h,      x,          y + h - ry );
-	vg_lineto  (x,          y + ry                             );
-	vg_curveto (x,          y,          x + rx,     y          );
-}
-
-void vg_char(float x, float y, float size, int c)
-{
-	if (!vg.state.font) return;
-	vg_font_draw_char(vg.state.font, x, y, size, c);
-}
-
-void vg_text(float x, float y, float size, const char *str)
-{
-	if (!vg.state.font) return;
-	vg_font_draw_text(vg.state.font, x, y, size, str, 0);
-}
-
-void vg_textn(float x, float y, float size, const char *str, const char *end)
-{
-	if (!vg.state.font) return;
-	vg_font_draw_text(vg.state.font, x, y, size, str, end);
-}
-
-void vg_textf(float x, float y, float size, const char *format, ...)
-{
-	va_list args; int length; char sbuff[512], *pbuff, *mbuff = 0;
-	va_start(args, format);
-	length = vsnprintf(0, 0, format, args);
-	va_end(args);
-	if (length < sizeof(sbuff)) pbuff = sbuff;
-	else pbuff = mbuff = malloc(length + 1);
-	va_start(args, format);
-	vsnprintf(pbuff, length + 1, format, args);
-	va_end(args);
-	vg_font_draw_text(vg.state.font, x, y, size, pbuff, pbuff + length);
-	if (mbuff) free(mbuff);
-}
-
-float vg_textw(float size, const char *str, const char *end)
-{
-	if (!vg.state.font) return 0;
-	return vg_font_measure_text(vg.state.font, size, str, end);
-}
-
-void vg_reset()
-{
-	vg.state.mode = VG_NONZERO;
-	vg.state.winding = VG_POSITIVE;
-	vg.state.alpha = 1.0f;
-	vg_identity();
-	vg_noclip();
-}
-
-void vg_push()
-{
-	vg_state_buffer[vg_state_count++] = vg.state;
-}
-
-void vg_pop()
-{
-	vg.state = vg_state_buffer[--vg_state_count];
-}
-
-void vg_mode(int mode)
-{
-	vg.state.mode = mode;
-}
-
-void vg_winding(int winding)
-{
-	vg.state.winding = winding;
-}
-
-void vg_spaa(float spaa)
-{
-	vg.state.spaa = spaa;
-}
-
-void vg_alpha(float alpha)
-{
-	if (alpha < 0) alpha = 0;
-	else if (alpha > 1) alpha = 1;
-	vg.state.alpha *= alpha;
-}
-
-void vg_font(vgFont *font)
-{
-	vg.state.font = font;
-}
-
-void vg_matrix(float *matrix)
-{
-	vg.state.matrix = *(vgMatrix*)matrix;
-}
-
-void vg_identity()
-{
-	vg_matrix_identity(vg.state.matrix.v);
-}
-
-void vg_translate(float x, float y)
-{
-	vg_matrix_translate(vg.state.matrix.v, x, y);
-}
-
-void vg_rotate(float degs)
-{
-	vg_matrix_rotate(vg.state.matrix.v, degs * (VG_PI / 180.0f));
-}
-
-void vg_rotater(float rads)
-{
-	vg_matrix_rotate(vg.state.matrix.v, rads);
-}
-
-void vg_scale(float x, float y)
-{
-	vg_matrix_scale(vg.state.matrix.v, x, y);
-}
-
-void vg_project(float *x, float *y)
-{
-	vg_matrix_project(vg.state.matrix.v, x, y);
-}
-
-void vg_unproject(float *x, float *y)
-{
-	vg_matrix_unproject(vg.state.matrix.v, x, y);
-}
-
-void vg_projectn(float *x, float *y)
-{
-	vg_matrix_projectn(vg.state.matrix.v, x, y);
-}
-
-void vg_unprojectn(float *x, float *y)
-{
-	vg_matrix_unprojectn(vg.state.matrix.v, x, y);
-}
-
-void vg_clip(float x, float y, float w, float h)
-{
-	x += 0.5f; y += 0.5f; w -= 1.0f; h -= 1.0f;
-	float iw = 1.0f / w, ih = 1.0f / h;
-	vg_matrix_inverse(vg.state.clip.v, vg.state.matrix.v);
-	vg.state.clip.v[0] = vg.state.clip.v[0] * iw;
-	vg.state.clip.v[1] = vg.state.clip.v[1] * iw;
-	vg.state.clip.v[2] = vg.state.clip.v[2] * iw - x * iw;
-	vg.state.clip.v[3] = vg.state.clip.v[3] * ih;
-	vg.state.clip.v[4] = vg.state.clip.v[4] * ih;
-	vg.state.clip.v[5] = vg.state.clip.v[5] * ih - y * ih;
-}
-
-void vg_noclip()
-{
-	vg.state.clip.v[0] = 0.0f;
-	vg.state.clip.v[1] = 0.0f;
-	vg.state.clip.v[2] = 0.5f;
-	vg.state.clip.v[3] = 0.0f;
-	vg.state.clip.v[4] = 0.0f;
-	vg.state.clip.v[5] = 0.5f;
-}
-
-/*//////////////////////////
-// POINT
-//////////////////////////*/
-
-int vg_point_norm(vgPoint *v, float *l)
-{
-	float d, i;
-	d = v->x*v->x + v->y*v->y;
-	if (d > 0) {
-		i = 1.0f / sqrtf(d);
-		v->x *= i;
-		v->y *= i;
-		*l = d;
-		return 1;
-	} else {
-		v->x = 0;
-		v->y = 0;
-		*l = 0;
-		return 0;
-	}
-}
-
-/*//////////////////////////
-// RECT
-//////////////////////////*/
-
-typedef struct vgRect {
-	int minx, miny;
-	int maxx, maxy;
-} vgRect;
-
-static vgRect vg_rect_add(vgRect a, int x, int y)
-{
-	vgRect r;
-	r.minx = a.minx < x ? a.minx : x;
-	r.miny = a.miny < y ? a.miny : y;
-	r.maxx = a.maxx > x ? a.maxx : x;
-	r.maxy = a.maxy > y ? a.maxy : y;
-	return r;
-}
-
-static vgRect vg_rect_inflate(vgRect a, int rx, int ry)
-{
-	vgRect r;
-	r.minx = a.minx - rx;
-	r.miny = a.miny - ry;
-	r.maxx = a.maxx + rx;
-	r.maxy = a.maxy + ry;
-	return r;
-}
-
-static vgRect vg_rect_clamp(vgRect a, vgRect b)
-{
-	vgRect r;
-	r.minx = a.minx > b.minx ? a.minx : b.minx;
-	r.miny = a.miny > b.miny ? a.miny : b.miny;
-	r.maxx = a.maxx < b.maxx ? a.maxx : b.maxx;
-	r.maxy = a.maxy < b.maxy ? a.maxy : b.maxy;
-	return r;
-}
-
-static vgRect vg_rect_union(vgRect a, vgRect b)
-{
-	vgRect c;
-	c.minx = a.minx < b.minx ? a.minx : b.minx;
-	c.miny = a.miny < b.miny ? a.miny : b.miny;
-	c.maxx = a.maxx > b.maxx ? a.maxx : b.maxx;
-	c.maxy = a.maxy > b.maxy ? a.maxy : b.maxy;
-	return c;
-}
-
-/*//////////////////////////
-// FILL
-//////////////////////////*/
-
-// VGL works by cutting paths into tiles and evaluating trapezoidal coverage on the GPU.
-// Edges use 8bit fixed-point coordinates(x0, y0, x1, y1), totaling 32bits per edge and are uploaded to a texture.
-// Tiles are rendered with quads using GPU instancing, each tile contains an edge-list pointer, fill-info pointer along with the sign (inside / outside) state of it's bottom-left corner.
-// A sign buffer is used to track when paths cross the top/bottom of tiles.
-// Before filling, the sign buffer is scanned from left to right, accumilating sign per tile.
-
-#define VG_GRID_SIZE   (1024)
-
-#define VG_MAX_DATA    (2048*2048)
-#define VG_MAX_TILES   (2048*128)
-#define VG_MAX_EDGES   (1 << 18)
-
-#define VG_PIXEL_LOG2  (4) // subpixel precision (16x16 for 256AA)
-#define VG_PIXEL_SIZE  (1 << VG_PIXEL_LOG2)
-#define VG_PIXEL_MASK  (VG_PIXEL_SIZE - 1)
-
-#define VG_TILE_LOG2   (7) // tile precision (128/16 for 8px per tile)
-#define VG_TILE_SIZE   (1 << VG_TILE_LOG2)
-#define VG_TILE_DIMS   (VG_TILE_SIZE / VG_PIXEL_SIZE)
-#define VG_TILE_MASK   (VG_TILE_SIZE - 1)
-
-#define VG_EDGE_LOG2   (8) // edge precision
-#define VG_EDGE_SIZE   (1 << VG_EDGE_LOG2)
-#define VG_EDGE_MASK   (VG_EDGE_SIZE - 1)
-#define VG_EDGE_BORDER ((VG_EDGE_SIZE - VG_TILE_SIZE) / 2)
-
-#define VG_FILL_FLAT    (0)
-#define VG_FILL_LIN     (1)
-#define VG_FILL_RAD     (2)
-#define VG_FILL_RAD_HUE (3)
-#define VG_FILL_RAD_SAT (4)
-#define VG_FILL_BOX     (5)
-#define VG_FILL_BOX_HUE (6)
-#define VG_FILL_BOX_SAT (7)
-#define VG_FILL_GRID    (8)
-
-#pragma pack(push, 1)
-
-typedef struct vgFill {
-	union {
-		struct {
-			char mode;
-			char type;
-			char spaa;
-			char rsv1;
-		};
-		unsigned args;
-	};
-	unsigned color0;
-	unsigned color1;
-	unsigned clip[6];
-	unsigned matrix[6];
-	unsigned extent[2];
-	unsigned radius[2];
-} vgFill;
-
-typedef struct vgTile {
-	union {
-		struct {
-			  signed short sign;
-			unsigned short count;
-		};
-		unsigned args;
-	};
-	float    data;
-	float    edges;
-	unsigned coord;
-} vgTile;
-
-typedef union vgEdge {
-	struct {
-		unsigned char x0;
-		unsigned char y0;
-		unsigned char x1;
-		unsigned char y1;
-	};
-	unsigned packed;
-} vgEdge;
-
-#pragma pack(pop)
-
-unsigned    vg_data_buffer[VG_MAX_DATA];
-int         vg_data_count;
-
-vgTile      vg_tile_buffer[VG_MAX_TILES];
-int         vg_tile_count;
-
-vgEdge      vg_edge_buffer[VG_MAX_EDGES];
-int         vg_edge_links[VG_MAX_EDGES];
-int         vg_edge_count;
-
-signed char vg_tile_sign[VG_GRID_SIZE * VG_GRID_SIZE];
-int         vg_tile_edge[VG_GRID_SIZE * VG_GRID_SIZE];
-
-float       vg_grid_scalex;
-float       vg_grid_scaley;
-int         vg_grid_sizex;
-int         vg_grid_sizey;
-vgRect      vg_grid_bounds;
-
-int         vg_fill_reset;
-vgPoint     vg_fill_start;
-vgPoint     vg_fill_point;
-int         vg_fill_winding;
-
-static void vg_push_fill(vgFill *fill, int ntiles, int nedges, unsigned** pdata, unsigned** pedges);
-static void vg_push_tile(int x, int y, int sign, void* data, void* edges, int count);
-static void vg_fill_lineto(float x, float y);
-
-static void vg_fill_prime()
-{
-	vg_data_count  = 0;
-	vg_tile_count  = 0;
-	vg_grid_scalex = vg.size.x / (float)VG_TILE_DIMS;
-	vg_grid_scaley = vg.size.y / (float)VG_TILE_DIMS;
-	vg_grid_sizex  = (int)ceilf(vg_grid_scalex) + 2;
-	vg_grid_sizey  = (int)ceilf(vg_grid_scaley) + 2;
-	memset(vg_tile_sign, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_sign[0]));
-	memset(vg_tile_edge, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_edge[0]));
-}
-
-static void vg_fill_flush()
-{
-	vg.stats.draws += 1;
-	vg.stats.tiles += vg_tile_count;
-	vg.stats.upload += sizeof(vgTile) * vg_tile_count + sizeof(vgEdge) * vg_edge_count;
-
-	vg_tile_count = 0;
-	vg_data_count = 0;
-}
-
-static void vg_fill_begin()
-{
-	vg_push_path();
-	vg_path_reset = 1;
-	vg_fill_reset = 1;
-	vg_fill_winding = vg.state.winding;
-
-	vg_edge_count = 1;
-	vg_grid_bounds.minx = vg_grid_sizex;
-	vg_grid_bounds.miny = vg_grid_sizey;
-	vg_grid_bounds.maxx = 0;
-	vg_grid_bounds.maxy = 0;
-}
-
-static void vg_fill_set(vgFill *fill, int mode, int type, unsigned c0, unsigned c1, float e0, float e1, float r0, float r1, vgMatrix *m)
-{
-	vgMatrix minv, mclip;
-	int spaa, alpha;
-	spaa = (int)(vg.state.spaa * 255);
-	spaa = spaa < 0 ? 0 : spaa > 255 ? 255 : spaa;
-	alpha = (int)(vg.state.alpha * 255);
-	alpha = alpha < 0 ? 0 : alpha > 255 ? 255 : alpha;
-	mclip = vg.state.clip;
-	vg_matrix_inverse(minv.v, m->v);
-	fill->mode = mode;
-	fill->type = type;
-	fill->spaa = spaa;
-	fill->color0 = VG_ALPHA(c0, alpha);
-	fill->color1 = VG_ALPHA(c1, alpha);
-	fill->clip[0] = *((unsigned*)&mclip.xx);
-	fill->clip[1] = *((unsigned*)&mclip.xy);
-	fill->clip[2] = *((unsigned*)&mclip.xt);
-	fill->clip[3] = *((unsigned*)&mclip.yx);
-	fill->clip[4] = *((unsigned*)&mclip.yy);
-	fill->clip[5] = *((unsigned*)&mclip.yt);
-	fill->matrix[0] = *((unsigned*)&minv.xx);
-	fill->matrix[1] = *((unsigned*)&minv.xy);
-	fill->matrix[2] = *((unsigned*)&minv.xt);
-	fill->matrix[3] = *((unsigned*)&minv.yx);
-	fill->matrix[4] = *((unsigned*)&minv.yy);
-	fill->matrix[5] = *((unsigned*)&minv.yt);
-	fill->extent[0] = *((unsigned*)&e0);
-	fill->extent[1] = *((unsigned*)&e1);
-	fill->radius[0] = *((unsigned*)&r0);
-	fill->radius[1] = *((unsigned*)&r1);
-}
-
-static void vg_push_fill(vgFill *fill, int ntiles, int nedges, unsigned** pdata, unsigned** pedges)
-{
-	int ifill, isize;
-	unsigned *data;
-
-	ifill = sizeof(vgFill) / 4;
-	isize = ifill + nedges * sizeof(vgEdge) / 4;
-
-	assert(ifill * 4 == sizeof(vgFill));
-	assert(ntiles <= VG_MAX_TILES);
-	assert(isize  <= VG_MAX_DATA);
-
-	if (vg_tile_count + ntiles > VG_MAX_TILES ||
-		vg_data_count + isize  > VG_MAX_DATA)
-		vg_flush();
-
-	data = &vg_data_buffer[vg_data_count];
-	*(vgFill*)data = *fill;
-	*pdata = data;
-	*pedges = data + ifill;
-	vg_data_count += ifill;
-}
-
-static void vg_push_tile(int x, int y, int sign, void *data, void *edges, int count)
-{
-	vgTile *tile;
-
-	assert(vg_tile_count + 1 <= VG_MAX_TILES);
-
-	tile = &vg_tile_buffer[vg_tile_count++];
-	tile->sign  = sign;
-	tile->count = count;
-	tile->coord = (x | (y << 16));
-	tile->data  = (float)((unsigned*)data  - vg_data_buffer);
-	tile->edges = (float)((unsigned*)edges - vg_data_buffer);
-
-	vg_data_count += count * sizeof(vgEdge) / 4;
-}
-
-static void vg_push_bounds(float x, float y)
-{
-	int ix, iy; vgRect bb;
-	ix = (int)(x / VG_TILE_DIMS);
-	iy = (int)(y / VG_TILE_DIMS);
-	bb = vg_grid_bounds;
-	vg_grid_bounds.minx = bb.minx < ix ? bb.minx : ix;
-	vg_grid_bounds.miny = bb.miny < iy ? bb.miny : iy;
-	vg_grid_bounds.maxx = bb.maxx > ix ? bb.maxx : ix;
-	vg_grid_bounds.maxy = bb.maxy > iy ? bb.maxy : iy;
-}
-
-static void vg_push_edge(int ix, int iy, int ax, int ay, int bx, int by)
-{
-	int index, previd, edgeid;
-	vgEdge edge;
-
-	if (vg_edge_count >= VG_MAX_EDGES  ||
-		(ax == bx && ay == by)         ||
-		ix < 0 || ix >= vg_grid_sizex  ||
-		iy < 0 || iy >= vg_grid_sizey)
-		return;
-
-	vg.stats.edges++;
-
-	index  = ix + iy * vg_grid_sizex;
-	previd = vg_tile_edge[index];
-	edgeid = vg_edge_count;
-
-	if (vg_fill_winding > 0) {
-		edge.x0 = ax - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.y0 = ay - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.x1 = bx - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.y1 = by - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
-	} else {
-		edge.x0 = bx - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.y0 = by - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.x1 = ax - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
-		edge.y1 = ay - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
-	}
-
-	vg_edge_buffer[edgeid] = edge;
-	vg_edge_links[edgeid] = previd;
-	vg_tile_edge[index] = edgeid;
-
-	vg_edge_count++;
-}
-
-static void vg_push_sign(int ix, int iy, int sign)
-{
-	if (iy >= vg_grid_sizey || iy < 0 ||
-		ix >= vg_grid_sizex)
-		return;
-
-	if (ix < 0)
-		ix = 0;
-
-	vg_tile_sign[ix + iy * vg_grid_sizex] -= sign * vg_fill_winding;
-}
-
-static void vg_push_sign_span(int iy0, int iy1)
-{
-	int dy, sv, sw;
-	signed char *sp, *se;
-
-	iy0 = iy0 < 0 ? 0 : iy0 >= vg_grid_sizey ? vg_grid_sizey - 1 : iy0;
-	iy1 = iy1 < 0 ? 0 : iy1 >= vg_grid_sizey ? vg_grid_sizey - 1 : iy1;
-
-	dy = iy1 - iy0;
-	sw = vg_grid_sizex;
-
-	if (dy > 0) {
-		sp = &vg_tile_sign[iy0 * sw];
-		se = sp + dy * sw;
-		sv = -vg_fill_winding;
-	} else
-	if (dy < 0) {
-		sp = &vg_tile_sign[iy1 * sw];
-		se = sp - dy * sw;
-		sv = +vg_fill_winding;
-	} else {
-		return;
-	}
-
-	while (sp != se) {
-		*sp += sv;
-		sp += sw;
-	}
-}
-
-static int vg_fill_closed()
-{
-	return
-		vg_fill_point.x == vg_fill_start.x &&
-		vg_fill_point.y == vg_fill_start.y;
-}
-
-static void vg_fill_close()
-{
-	if (!vg_fill_reset && !vg_fill_closed())
-		vg_fill_lineto(vg_fill_start.x - VG_TILE_DIMS, vg_fill_start.y);
-	vg_fill_reset = 1;
-}
-
-static void vg_fill_moveto_base(float x, float y)
-{
-	vg_fill_reset = 0;
-	vg_fill_start.x = x;
-	vg_fill_start.y = y;
-	vg_fill_point.x = x;
-	vg_fill_point.y = y;
-	vg_push_bounds(x, y);
-}
-
-static void vg_fill_moveto(float x, float y)
-{
-	vg_fill_moveto_base(x + VG_TILE_DIMS, y);
-}
-
-static void vg_fill_lineto_base(float x, float y)
-{
-	int dx, dy, lx, ly, tx, ty;
-	int tx0, ty0, tx1, ty1;
-	int ix0, iy0, ix1, iy1;
-	int x0, y0, x1, y1;
-	int sx, sy, fx, fy;
-	int ex, ey, er;
-	int nx, ny, ni;
-
-	if (vg_fill_reset) {
-		vg_fill_moveto_base(x, y);
-		return;
-	}
-
-	// TODO: clip line?
-
-	x0 = (int)(vg_fill_point.x * VG_PIXEL_SIZE);
-	y0 = (int)(vg_fill_point.y * VG_PIXEL_SIZE);
-	x1 = (int)(x * VG_PIXEL_SIZE);
-	y1 = (int)(y * VG_PIXEL_SIZE);
-
-	if (x0 == x1 && y0 == y1)
-		return;
-
-	ix0 = x0 >> VG_TILE_LOG2;
-	iy0 = y0 >> VG_TILE_LOG2;
-	ix1 = x1 >> VG_TILE_LOG2;
-	iy1 = y1 >> VG_TILE_LOG2;
-
-	if ((iy0 < 0 && iy1 < 0) ||
-		(ix0 > vg_grid_sizex && ix1 > vg_grid_sizex) ||
-		(iy0 > vg_grid_sizey && iy1 > vg_grid_sizey)) {
-		goto pass;
-	}
-
-	if (x0 < 0 && x1 < 0) {
-		vg_push_sign_span(iy0, iy1);
-		goto pass;
-	}
-
-	dx = abs(x1 - x0);
-	dy = abs(y1 - y0);
-
-	if (dx >= (64 << VG_TILE_LOG2) ||
-		dy >= (64 << VG_TILE_LOG2)) {
-		vg_fill_lineto_base(
-			(vg_fill_point.x + x) * 0.5f,
-			(vg_fill_point.y + y) * 0.5f);
-		vg_fill_lineto_base(x, y);
-		return;
-	}
-
-	nx = abs(ix1 - ix0);
-	ny = abs(iy1 - iy0);
-	ni = nx + ny;
-
-	sx = x1 >= x0 ? 1 : -1;
-	sy = y1 >= y0 ? 1 : -1;
-	lx = dy > 0 ? (dx << VG_EDGE_LOG2 << VG_TILE_LOG2) / dy * sx : 0;
-	ly = dx > 0 ? (dy << VG_EDGE_LOG2 << VG_TILE_LOG2) / dx * sy : 0;
-	fx = ((sx > 0 ? VG_TILE_MASK - x0 : x0) & VG_TILE_MASK);
-	fy = ((sy > 0 ? VG_TILE_MASK - y0 : y0) & VG_TILE_MASK);
-	tx = (lx * (fy << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
-	ty = (ly * (fx << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
-
-	tx0 = tx1 = x0;
-	ty0 = ty1 = y0;
-	ix1 = ix0;
-	iy1 = iy0;
-
-	ex = -(dy << VG_TILE_LOG2);
-	ey =  (dx << VG_TILE_LOG2);
-	er =  (dx * (fy + 1)) - (dy * (fx + 1));
-
-	// TODO: preallocate edges? (ni + nx * 2)
-
-	while (ni-- >= 0) {
-		tx0 = tx1;
-		ty0 = ty1;
-		ix0 = ix1;
-		iy0 = iy1;
-
-		if (ni == -1) {
-			tx1 = x1;
-			ty1 = y1;
-		} else
-			if (er > 0) {
-				tx1 = ((ix0 + (sx > 0)) << VG_TILE_LOG2);
-				ty1 = y0 + (ty >> VG_EDGE_LOG2);
-
-				er += ex;
-				ty += ly;
-				ix1 += sx;
-
-				if (sx > 0)
-					vg_push_edge(ix1, iy1, tx1 - 32, (iy1 << VG_TILE_LOG2), tx1 - 32, ty1);
-				else
-					vg_push_edge(ix0, iy0, tx1 - 32, ty1, tx1 - 32, (iy0 << VG_TILE_LOG2));
-			} else {
-				tx1 = x0 + (tx >> VG_EDGE_LOG2);
-				ty1 = ((iy0 + (sy > 0)) << VG_TILE_LOG2);
-
-				er += ey;
-				tx += lx;
-				iy1 += sy;
-
-				if (sy > 0)
-					vg_push_sign(ix0, iy0, +1);
-				else
-					vg_push_sign(ix1, iy1, -1);
-			}
-
-		vg_push_edge(ix0, iy0, tx0, ty0, tx1, ty1);
-	}
-
-pass:
-	vg_fill_point.x = x;
-	vg_fill_point.y = y;
-	vg_push_bounds(x, y);
-}
-
-static void vg_fill_lineto(float x, float y)
-{
-	vg_fill_lineto_base(x + VG_TILE_DIMS, y);
-}
-
-static void vg_fill_draw(vgFill *fill)
-{
-	vgRect rect; vgEdge edge;
-	unsigned *data, *edges, *edgep;
-	int index, sign, link, x, y;
-	int sizex, sizey, count;
-
-	rect = vg_grid_bounds;
-	if (rect.minx > rect.maxx)
-		return;
-
-	rect.minx -= 1;
-	rect.maxx += 1;
-	rect.maxy += 1;
-	rect = vg_rect_clamp(rect, (vgRect) { 0, 0, vg_grid_sizex - 1, vg_grid_sizey - 1 });
-
-	sizex = rect.maxx - rect.minx - 1;
-	sizey = rect.maxy - rect.miny;
-
-	if (sizex <= 0 || sizey <= 0)
-		return;
-
-	vg_push_fill(fill, sizex * sizey, vg_edge_count - 1, &data, &edges);
-
-	for (y = 0; y < sizey; y++) {
-		sign = 0;
-		index = rect.minx + (rect.miny + y) * vg_grid_sizex;
-		for (x = 0; x <= sizex; x++, index++) {
-			if (x > 0) {
-				count = 0;
-				edgep = edges;
-				link = vg_tile_edge[index];
-				while (link) {
-					edge = vg_edge_buffer[link];
-					link = vg_edge_links[link];
-					*(edges++) = edge.packed;
-					count++;
-				}
-				if (sign != 0 || count > 0) {
-					vg_push_tile(
-						rect.minx + x - 1,
-						rect.miny + y,
-						sign, data, edgep, count);
-				}
-			}
-			sign += vg_tile_sign[index];
-			vg_tile_sign[index] = 0;
-			vg_tile_edge[index] = 0;
-		}
-	}
-}
-
-static void vg_fill_base(vgFill *fill)
-{
-	vgPoint point;
-	vgPath path;
-	int index;
-
-	vg_fill_begin();
-
-	for (index = 0; index < vg_path_count;) {
-		path = vg_path_buffer[index++];
-		point = vg_path_buffer[index++].point;
-		vg_fill_winding = path.winding ? 1 : -1;
-		vg_fill_moveto(point.x, point.y);
-		while (index < path.end) {
-			point = vg_path_buffer[index++].point;
-			vg_fill_lineto(point.x, point.y);
-		}
-	}
-
-	vg_fill_close();
-	vg_fill_draw(fill);
-}
-
-void vg_fill(unsigned color)
-{
-	vgFill fill;
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_FLAT, color, color, 0, 0, 0, 0, &vg.state.matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillr(unsigned c0, unsigned c1, float x, float y, float r0, float r1)
-{
-	vgMatrix matrix;
-	vgFill fill;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD, c0, c1, 0, 0, r0, r1, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillrh(float x, float y, float r0, float r1, float sat, float val)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD_HUE, 0xFFFFFFFF, 0xFFFFFFFF, sat, val, r0, r1, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillrs(float x, float y, float r0, float r1, float hue)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD_SAT, 0xFFFFFFFF, 0xFFFFFFFF, hue, 0, r0, r1, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillb(unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x + w / 2, y + h / 2);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX, c0, c1, w / 2, h / 2, r0, r1, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillg(unsigned c0, unsigned c1, float x0, float y0, float x1, float y1)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x0, y0);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_LIN, c0, c1, x1 - x0, y1 - y0, 0, 0, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillbh(float x, float y, float w, float h, float sat, float val)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_matrix_scale(matrix.v, w, h);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX_HUE, 0xFFFFFFFF, 0xFFFFFFFF, sat, val, 0, 0, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillbs(float x, float y, float w, float h, float hue)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_matrix_scale(matrix.v, w, h);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX_SAT, 0xFFFFFFFF, 0xFFFFFFFF, hue, 0, 0, 0, &matrix);
-	vg_fill_base(&fill);
-}
-
-void vg_fillgr(unsigned c0, unsigned c1, float x, float y, float w, float h, float r)
-{
-	vgFill fill;
-	vgMatrix matrix;
-	matrix = vg.state.matrix;
-	vg_matrix_translate(matrix.v, x, y);
-	vg_fill_set(&fill, vg.state.mode, VG_FILL_GRID, c0, c1, w, h, r, 0, &matrix);
-	vg_fill_base(&fill);
-}
-
-/*//////////////////////////
-// STROKE
-//////////////////////////*/
-
-vgPoint vg_stroke_norm[VG_MAX_PATH];
-
-void vg_stroke(unsigned color, float width)
-{
-	vgPoint p0, p1, n0, n1;
-	vgMatrix mt, mi;
-	vgPath path;
-	vgFill fill;
-	float l, r;
-	int i, j;
-
-	vg_fill_begin();
-
-	r = width / 2.0f;
-	mt = vg.state.matrix;
-	vg_matrix_inverse(mi.v, mt.v);
-
-	for (i = 0; i < vg_path_count;) {
-		path = vg_path_buffer[i++];
-		p0 = vg_path_buffer[i].point;
-		for (j = i + 1; j < path.end; j++) {
-			p1 = vg_path_buffer[j].point;
-			n0.x = p1.y - p0.y;
-			n0.y = p0.x - p1.x;
-			n1.x = n0.x * mi.xx + n0.y * mi.xy;
-			n1.y = n0.x * mi.yx + n0.y * mi.yy;
-			vg_point_norm(&n1, &l);
-			n0.x = (n1.x * mt.xx + n1.y * mt.xy) * r;
-			n0.y = (n1.x * mt.yx + n1.y * mt.yy) * r;
-			vg_stroke_norm[j - 1] = n0;
-			p0 = p1;
-		}
-		i = path.end;
-	}
-
-	for (i = 0; i < vg_path_count;) {
-		vg_path_reset = 1;
-		path = vg_path_buffer[i++];
-		p0 = vg_path_buffer[i].point;
-		n0 = vg_stroke_norm[i];
-		vg_fill_winding = path.winding ? 1 : -1;
-		for (j = i + 1; j < path.end; j++) {
-			p1 = vg_path_buffer[j].point;
-			n1 = vg_stroke_norm[j];
-			vg_fill_lineto(p0.x + n0.x, p0.y + n0.y);
-			vg_fill_lineto(p1.x + n0.x, p1.y + n0.y);
-			p0 = p1;
-			n0 = n1;
-		}
-		if (path.closed) vg_fill_close();
-		for (j = path.closed ? path.end - 2 : path.end - 1; j >= i; j--) {
-			p1 = vg_path_buffer[j].point;
-			n1 = vg_stroke_norm[j];
-			vg_fill_lineto(p0.x - n1.x, p0.y - n1.y);
-			vg_fill_lineto(p1.x - n1.x, p1.y - n1.y);
-			p0 = p1;
-		}
-		vg_fill_close();
-		i = path.end;
-	}
-
-	vg_fill_set(&fill, VG_NONZERO, VG_FILL_FLAT, color, color, 0, 0, 0, 0, &mt);
-	vg_fill_draw(&fill);
-}
-
-/*//////////////////////////
-// DRIVER
-//////////////////////////*/
-
-#ifndef VGL_LOG
-#define VGL_LOG(msg) printf("%s: %d: %s\n", __FILE__, __LINE__, msg)
-#endif
-
-#define VGL_SHADER_(...) #__VA_ARGS__
-#define VGL_SHADER(...)  VGL_SHADER_(__VA_ARGS__)
-
-/*//////////////////////////
-// DRIVER: OPENGL
-//////////////////////////*/
-
-#if VGL_DRIVER == VGL_OPENGL
-
-#undef min
-#undef max
-
-#define VGL_VERSION "#version 330\n"
-
-#define VGL_TRACE() do {\
-	GLenum err;\
-	while ((err = glGetError()) != GL_NO_ERROR) {\
-		GLchar errmsg[64];\
-		sprintf(errmsg, "opengl: error: %i %s [%i]", err, __FILE__, __LINE__);\
-		VGL_LOG(errmsg);\
-	}} while(0)
-
-const GLchar* vgl_shader_lib =
-VGL_VERSION
-VGL_SHADER(
-	precision highp float;
-	precision highp int;
-
-	uniform usampler2D udata;
-	uniform ivec2 uscreensize;
-	uniform ivec2 udatasize;
-
-	int du8(const uint v) {
-		return int(v);
-	}
-
-	int du16(const uvec2 v) {
-		return int(v.r + (v.g << 8));
-	}
-
-	int du24(const uvec3 v) {
-		return int(v.r + (v.g << 8) + (v.b << 16));
-	}
-
-	uint du32(const uvec4 v) {
-		return v.r + (v.g << 8) + (v.b << 16) + (v.a << 24);
-	}
-
-	int di8(const uint v) {
-		int r = int(v); return r > 127 ? r - 256 : r;
-	}
-
-	int di16(const uvec2 v) {
-		int r = int(du16(v)); return r > 32767 ? r - 65536 : r;
-	}
-
-	int di24(const uvec3 v) {
-		int r = int(du24(v)); return r > 8388607 ? r - 16777216 : r;
-	}
-
-	int di32(const uvec4 v) {
-		return int(du32(v));
-	}
-
-	float df8(const uint v) {
-		return float(v) / 255.0;
-	}
-
-	float df32(const uvec4 v) {
-		return uintBitsToFloat(v.r + (v.g << 8) + (v.b << 16) + (v.a << 24));
-	}
-
-	vec4 dv4(const uvec4 v) {
-		return vec4(v) / 255.0;
-	}
-
-	uvec4 get_value(const int index) {
-		return texelFetch(udata, ivec2(index % udatasize.x, index / udatasize.x), 0);
-	}
-
-	vec3 hsv2rgb(vec3 c) {
-		vec4 K = vec4(1.0, 2.0 / 3.0, 1.0 / 3.0, 3.0);
-		vec3 p = abs(fract(c.xxx + K.xyz) * 6.0 - K.www);
-		return c.z * mix(K.xxx, clamp(p - K.xxx, 0.0, 1.0), c.y);
-	}
-
-	vec3 rgb2hsv(vec3 c) {
-		vec4 K = vec4(0.0, -1.0 / 3.0, 2.0 / 3.0, -1.0);
-		vec4 p = mix(vec4(c.bg, K.wz), vec4(c.gb, K.xy), step(c.b, c.g));
-		vec4 q = mix(vec4(p.xyw, c.r), vec4(c.r, p.yzx), step(p.x, c.r));
-		float d = q.x - min(q.w, q.y);
-		float e = 1.0e-10;
-		return vec3(abs(q.z + (q.w - q.y) / (6.0 * d + e)), d / (q.x + e), q.x);
-	}
-);
-
-const GLchar* vgl_shader_vs =
-VGL_SHADER(
-	in vec4  iargs;
-	in float idata;
-	in float iedges;
-	in vec4  icoord;
-
-	flat out int    vmode;
-	flat out int    vfill;
-	flat out float  vspaa;
-	flat out int    vsign;
-	flat out int    vcount;
-	flat out int    vindex;
-	flat out ivec2  vcoord;
-	flat out vec4   vcolor0;
-	flat out vec4   vcolor1;
-	flat out vec2   vextent;
-	flat out vec2   vradius;
-	flat out vec2   vscale;
-
-	out vec2 vpixel;
-	out vec2 vscreen;
-	out vec2 vclip;
-	out vec2 vgrad;
-
-// 	const vec2 QUAD[6] = {
-// 		{ 0.0f, 0.0f },
-// 		{ 1.0f, 0.0f },
-// 		{ 1.0f, 1.0f },
-// 		{ 0.0f, 0.0f },
-// 		{ 1.0f, 1.0f },
-// 		{ 0.0f, 1.0f },
-// 	};
-
-	const float QUAD[12] = float[12] (
-		0.0f, 0.0f,
-		1.0f, 0.0f,
-		1.0f, 1.0f,
-		0.0f, 0.0f,
-		1.0f, 1.0f,
-		0.0f, 1.0f
-	);
-
-	void main() {
-		int data; uvec4 args;
-		data = int(idata);
-		args = get_value(data);
-
-		vmode   = di8(args.r);
-		vfill   = di8(args.g);
-		vspaa   = df8(args.b);
-		vcolor0 = dv4(get_value(data + 1));
-		vcolor1 = dv4(get_value(data + 2));
-		vsign   = di16(uvec2(iargs.rg*255));
-		vcount  = du16(uvec2(iargs.ba*255));
-		vindex  = int(iedges);
-		vcoord  = ivec2(du16(uvec2(icoord.rg*255)), du16(uvec2(icoord.ba*255)));
-		vpixel  = vec2(QUAD[gl_VertexID], QUAD[gl_VertexID+1]) * VG_TILE_DIMS;
-		vscreen = vec2(vcoord * VG_TILE_DIMS + vpixel);
-
-		mat2x3 mclip;
-		mclip[0].x = df32(get_value(data + 3));
-		mclip[0].y = df32(get_value(data + 4));
-		mclip[0].z = df32(get_value(data + 5));
-		mclip[1].x = df32(get_value(data + 6));
-		mclip[1].y = df32(get_value(data + 7));
-		mclip[1].z = df32(get_value(data + 8));
-		vclip = (vec3(vscreen, 1.0) * mclip).xy;
-
-		if (vfill != VG_FILL_FLAT) {
-			mat2x3 mgrad;
-			mgrad[0].x = df32(get_value(data + 9));
-			mgrad[0].y = df32(get_value(data + 10));
-			mgrad[0].z = df32(get_value(data + 11));
-			mgrad[1].x = df32(get_value(data + 12));
-			mgrad[1].y = df32(get_value(data + 13));
-			mgrad[1].z = df32(get_value(data + 14));
-			vgrad = (vec3(vscreen, 1.0) * mgrad).xy;
-			vscale = abs(mgrad[0].xy) + abs(mgrad[1].xy);
-			vextent.x = df32(get_value(data + 15));
-			vextent.y = df32(get_value(data + 16));
-			vradius.x = df32(get_value(data + 17));
-			vradius.y = df32(get_value(data + 18));
-		} else {
-			vgrad = vec2(0.0);
-			vscale = vec2(1.0);
-		}
-
-		gl_Position = vec4((vscreen / uscreensize * 2.0 - 1.0) * vec2(1.0, -1.0), 0.0, 1.0);
-	}
-);
-
-const GLchar* vgl_shader_fs =
-VGL_SHADER(
-	flat in int    vmode;
-	flat in int    vfill;
-	flat in float  vspaa;
-	flat in int    vsign;
-	flat in int    vcount;
-	flat in int    vindex;
-	flat in ivec2  vcoord;
-	flat in vec4   vcolor0;
-	flat in vec4   vcolor1;
-	flat in vec2   vextent;
-	flat in vec2   vradius;
-	flat in vec2   vscale;
-
-	in vec2 vpixel;
-	in vec2 vscreen;
-	in vec2 vclip;
-	in vec2 vgrad;
-
-	vec2 pixel;
-
-	layout(location = 0, index = 0) out vec4 fcolor;
-	layout(location = 0, index = 1) out vec4 fmask;
-
-	float eval_area(vec2 a, vec2 b, in vec2 l, in vec2 window) {
-		float ta, tb, ty, th;
-		float area = 0.0;
-
-		/* right */
-		if (sign(a.x - window.y) != sign(b.x - window.y)) {
-			if (a.x < b.x) {
-				b.y = b.y - (b.x - window.y) * l.y;
-				b.x = window.y;
-			} else {
-				a.y = a.y - (a.x - window.y) * l.y;
-				a.x = window.y;
-			}
-		} else if (a.x > window.y) {
-			return 0.0;
-		}
-
-		/* left intersection */
-		if (sign(a.x - window.x) != sign(b.x - window.x)) {
-			// split edge into a rectangle and a trapezoid
-			// append rectangle area here and update
-			// coordinates to form the remaining trapezoid
-			if (a.x < b.x) {
-				ty = a.y - (a.x - window.x) * l.y;
-				th = ty - a.y;
-				a.y = ty;
-				a.x = window.x;
-			} else {
-				ty = b.y - (b.x - window.x) * l.y;
-				th = b.y - ty;
-				b.y = ty;
-				b.x = window.x;
-			}
-			/* signed area of rectangle (unit x) */
-			area -= th;
-		}
-
-		/* signed area of trapezoid */
-		th = clamp(b.y - a.y, -1.0, 1.0);
-		ta = clamp(window.y - a.x, 0.0, (window.y - window.x)) / (window.y - window.x);
-		tb = clamp(window.y - b.x, 0.0, (window.y - window.x)) / (window.y - window.x);
-		area -= (ta + tb) * 0.5 * th;
-
-		return area;
-	}
-
-	vec3 eval_cover() {
-		vec2 wr, wg, wb;
-		vec2 a, b, d, l;
-		int idx, end;
-		vec4 edge;
-		vec3 area;
-
-		idx =  vindex;
-		end  = vindex + vcount;
-		area = vec3(vsign);
-
-		if (vspaa > 0.0) {
-			wr = vec2(      0.0, 1.0 / 3.0);
-			wg = vec2(1.0 / 3.0, 2.0 / 3.0);
-			wb = vec2(2.0 / 3.0,       1.0);
-		}
-
-		while (idx < end) {
-			edge  = dv4(get_value(idx++));
-			edge *= float(VG_EDGE_MASK);
-			edge -= float(VG_EDGE_BORDER);
-			edge /= float(VG_PIXEL_SIZE);
-			edge -= pixel.xyxy;
-
-			a = edge.xy;
-			b = edge.zw;
-			d = b - a;
-			l = vec2(d.x / d.y, d.y / d.x);
-
-			/* top  */
-			if (sign(a.y) != sign(b.y)) {
-				if (d.y > 0) {
-					a.x = a.x - a.y * l.x;
-					a.y = 0.0f;
-				} else {
-					b.x = b.x - b.y * l.x;
-					b.y = 0.0f;
-				}
-			} else if (a.y < 0) {
-				continue;
-			}
-
-			/* bottom  */
-			if (sign(a.y - 1) != sign(b.y - 1)) {
-				if (d.y > 0) {
-					b.x = b.x - (b.y - 1) * l.x;
-					b.y = 1.0f;
-				} else {
-					a.x = a.x - (a.y - 1) * l.x;
-					a.y = 1.0f;
-				}
-			} else if (a.y > 1) {
-				continue;
-			}
-
-			if (vspaa > 0.0) {
-				area.r += eval_area(a, b, l, wr);
-				area.g += eval_area(a, b, l, wg);
-				area.b += eval_area(a, b, l, wb);
-			} else {
-				area += eval_area(a, b, l, vec2(0.0, 1.0));
-			}
-		}
-
-		if (vspaa > 0.0 && vspaa < 1.0) {
-			area = mix(vec3(dot(area, vec3(1.0 / 3.0))), area, vspaa);
-		}
-
-		return area;
-	}
-
-	vec3 eval_alpha() {
-		vec3 c, a;
-		c = eval_cover();
-		switch (vmode) {
-		case VG_NEGATIVE:
-			a = clamp(-c, 0.0, 1.0);
-			break;
-		case VG_POSITIVE:
-			a = clamp(c, 0.0, 1.0);
-			break;
-		case VG_NONZERO:
-			a = abs(clamp(c, -1.0, 1.0));
-			break;
-		case VG_EVENODD:
-			a = abs(mod(c + 1.0, 2.0) - 1.0);
-			break;
-		case VG_INTERSECTION:
-			a = clamp(abs(c) - 1.0, 0.0, 1.0);
-			break;
-		default:
-			a = clamp(c, 0.0, 1.0);
-			break;
-		}
-		return a;
-	}
-
-	float eval_dither(float seed) {
-		vec3 p = fract(vec3(vscreen.xyx) * vec3(443.8975, 397.2973, 491.1871));
-		p += dot(p, p.yzx + 19.19 + seed);
-		return (fract((p.x + p.y) * p.z) - 0.5) * (1.0 / 128.0);
-	}
-
-	vec4 eval_color() {
-		float d, a, r, w, b; vec2 v;
-		switch (vfill) {
-		case VG_FILL_LIN:
-			d = sqrt(dot(vgrad, vextent));
-			a = clamp(d / length(vextent), 0.0, 1.0);
-			return mix(vcolor0, vcolor1, a);
-		case VG_FILL_RAD:
-			d = length(vgrad) - vradius.x;
-			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
-			return mix(vcolor0, vcolor1, a);
-		case VG_FILL_RAD_HUE:
-			d = length(vgrad) - vradius.x;
-			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
-			v = normalize(vgrad);
-			r = acos(v.x) * sign(v.y) / VG_PI2 + 0.5;
-			return vec4(hsv2rgb(vec3(r, vextent.x * a, vextent.y * (1.0 - a) + a)), 1.0) * vcolor0;
-		case VG_FILL_RAD_SAT:
-			d = length(vgrad) - vradius.x;
-			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
-			r = length(vgrad / (vradius.y - vradius.x) / 2.0 + 0.5);
-			return vec4(hsv2rgb(vec3(vextent.x, r, a)), 1.0) * vcolor0;
-		case VG_FILL_BOX:
-			r = abs(vradius.y - vradius.x);
-			v = abs(vgrad) - (vextent - r);
-			d = length(max(v, 0.0)) + min(max(v.x, v.y), 0.0) - vradius.x - r;
-			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
-			return mix(vcolor0, vcolor1, a);
-		case VG_FILL_BOX_HUE:
-			v = clamp(vgrad, 0.0, 1.0);
-			return vec4(hsv2rgb(vec3(v.x, vextent.x, vextent.y)), 1.0) * vcolor0;
-		case VG_FILL_BOX_SAT:
-			v = clamp(vgrad, 0.0, 1.0);
-			return vec4(hsv2rgb(vec3(vextent.x, v.x, v.y)), 1.0) * vcolor0;
-		case VG_FILL_GRID:
-			v = abs(fract(vgrad / vextent) - 0.5) - (0.5 - vradius.x / vextent);
-			w = dot(vscale / vextent, vec2(0.5));
-			d = max(v.x, v.y);
-			a = smoothstep(w, -w, d);
-			return mix(vcolor0, vcolor1, a);
-		default:
-			a = 0.0;
-			return vcolor0;
-		}
-	}
-
-	float eval_clip() {
-		vec2  r = abs(vclip - 0.5) - vec2(0.5);
-		float d = length(max(r, 0.0)) + min(max(r.x, r.y), 0.0);
-		float w = fwidth(d);
-		return smoothstep(w, -w, d);
-	}
-
-	void main() {
-		vec4 color, alpha;
-		pixel  = floor(vpixel);
-		color  = eval_color();
-		alpha  = vec4(eval_alpha(), 1.0) * color.a * eval_clip();
-		fcolor = color * alpha;
-		fmask  = alpha;
-	}
-);
-
-GLuint vgl_shader;
-GLuint vgl_shader_uscreensize;
-GLuint vgl_shader_udatasize;
-GLuint vgl_shader_iargs;
-GLuint vgl_shader_idata;
-GLuint vgl_shader_iedges;
-GLuint vgl_shader_icoord;
-
-GLuint vgl_buffer_vao;
-GLuint vgl_buffer_data;
-GLuint vgl_buffer_draw;
-GLuint vgl_buffer_size;
-
-void vg_driver_init()
-{
-	static char log[1024];
-	const GLchar *source[2];
-	GLuint shader;
-	GLint result;
-
-	glGenTextures(1, &vgl_buffer_data);
-	glBindTexture(GL_TEXTURE_2D, vgl_buffer_data);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8UI, vgl_buffer_size, vgl_buffer_size, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, vg_data_buffer);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	VGL_TRACE();
-
-	vgl_shader = glCreateProgram();
-
-	shader = glCreateShader(GL_VERTEX_SHADER);
-	source[0] = vgl_shader_lib;
-	source[1] = vgl_shader_vs;
-	glShaderSource(shader, 2, source, 0);
-	glCompileShader(shader);
-	glAttachShader(vgl_shader, shader);
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &result);
-	if (result == GL_FALSE) {
-		glGetShaderInfoLog(shader, sizeof(log), 0, log);
-		VGL_LOG(log);
-	}
-	VGL_TRACE();
-
-	shader = glCreateShader(GL_FRAGMENT_SHADER);
-	source[0] = vgl_shader_lib;
-	source[1] = vgl_shader_fs;
-	glShaderSource(shader, 2, source, 0);
-	glCompileShader(shader);
-	glAttachShader(vgl_shader, shader);
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &result);
-	if (result == GL_FALSE) {
-		glGetShaderInfoLog(shader, sizeof(log), 0, log);
-		VGL_LOG(log);
-	}
-	VGL_TRACE();
-
-	glLinkProgram(vgl_shader);
-	glGetProgramiv(vgl_shader, GL_LINK_STATUS, &result);
-	if (result == GL_FALSE) {
-		glGetProgramInfoLog(vgl_shader, sizeof(log), 0, log);
-		VGL_LOG(log);
-	}
-	VGL_TRACE();
-
-	vgl_shader_uscreensize = glGetUniformLocation(vgl_shader, "uscreensize");
-	vgl_shader_udatasize   = glGetUniformLocation(vgl_shader, "udatasize");
-	vgl_shader_iargs       = glGetAttribLocation(vgl_shader, "iargs");
-	vgl_shader_idata       = glGetAttribLocation(vgl_shader, "idata");
-	vgl_shader_iedges      = glGetAttribLocation(vgl_shader, "iedges");
-	vgl_shader_icoord      = glGetAttribLocation(vgl_shader, "icoord");
-
-	vgl_buffer_size = (int)ceilf(sqrtf(VG_MAX_DATA));
-
-	glGenVertexArrays(1, &vgl_buffer_vao);
-	glBindVertexArray(vgl_buffer_vao);
-	VGL_TRACE();
-
-	glGenBuffers(1, &vgl_buffer_draw);
-	glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vg_tile_buffer), NULL, GL_DYNAMIC_DRAW);
-	VGL_TRACE();
-
-	glEnableVertexAttribArray(vgl_shader_iargs);
-	glVertexAttribPointer(vgl_shader_iargs, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(vgTile), &((vgTile*)0)->args);
-	glVertexAttribDivisor(vgl_shader_iargs, 1);
-	VGL_TRACE();
-
-	glEnableVertexAttribArray(vgl_shader_idata);
-	glVertexAttribPointer(vgl_shader_idata, 1, GL_FLOAT, GL_FALSE, sizeof(vgTile), &((vgTile*)0)->data);
-	glVertexAttribDivisor(vgl_shader_idata, 1);
-	VGL_TRACE();
-
-	glEnableVertexAttribArray(vgl_shader_iedges);
-	glVertexAttribPointer(vgl_shader_iedges, 1, GL_FLOAT, GL_FALSE, sizeof(vgTile), &((vgTile*)0)->edges);
-	glVertexAttribDivisor(vgl_shader_iedges, 1);
-	VGL_TRACE();
-
-	glEnableVertexAttribArray(vgl_shader_icoord);
-	glVertexAttribPointer(vgl_shader_icoord, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(vgTile), &((vgTile*)0)->coord);
-	glVertexAttribDivisor(vgl_shader_icoord, 1);
-	VGL_TRACE();
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
-}
-
-void vg_driver_prime()
-{
-	glDisable(GL_CULL_FACE);
-	glDisable(GL_SCISSOR_TEST);
-	glDisable(GL_DEPTH_TEST);
-	glDisable(GL_STENCIL_TEST);
-	VGL_TRACE();
-
-	glEnable(GL_BLEND);
-	glBlendEquation(GL_FUNC_ADD);
-	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC1_COLOR);
-	VGL_TRACE();
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, vgl_buffer_data);
-	glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
-	glBindVertexArray(vgl_buffer_vao);
-	VGL_TRACE();
-
-	glUseProgram(vgl_shader);
-	VGL_TRACE();
-	glUniform2i(vgl_shader_uscreensize, vg.size.x, vg.size.y);
-	VGL_TRACE();
-	glUniform2i(vgl_shader_udatasize, vgl_buffer_size, vgl_buffer_size);
-	VGL_TRACE();
-}
-
-void vg_driver_flush()
-{
-	if (vg_tile_count == 0)
-		return;
-
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8UI, vgl_buffer_size, (vg_data_count + vgl_buffer_size - 1) / vgl_buffer_size, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, vg_data_buffer);
-	// TODO: find out what's wrong with this
-	//glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, vgl_buffer_size, (vg_data_count + vgl_buffer_size - 1) / vgl_buffer_size, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, vg_data_buffer);
-	VGL_TRACE();
-
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vgTile) * vg_tile_count, vg_tile_buffer);
-	VGL_TRACE();
-
-	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, vg_tile_count);
-	VGL_TRACE();
-}
-
-void vg_driver_clear(unsigned color)
-{
-	float r, g, b, a;
-	r = ((color >> 0)  & 0xFF) / 255.0f;
-	g = ((color >> 8)  & 0xFF) / 255.0f;
-	b = ((color >> 16) & 0xFF) / 255.0f;
-	a = ((color >> 24) & 0xFF) / 255.0f;
-	glClearColor(r, g, b, a);
-	glClear(GL_COLOR_BUFFER_BIT);
-}
-
-void vg_driver_size(int *w, int *h)
-{
-	GLint viewport[4];
-	glGetIntegerv(GL_VIEWPORT, viewport);
-	*w = viewport[2];
-	*h = viewport[3];
-}
-
-#endif
-
-/*//////////////////////////
-// DRIVER: VULKAN
-//////////////////////////*/
-
-#if VGL_DRIVER == VGL_VULKAN
-// NOT IMPLEMENTED
-#endif
-
-/*//////////////////////////
-// DRIVER: DIRECTX
-//////////////////////////*/
-
-#if VGL_DRIVER == VGL_DIRECTX
-// NOT IMPLEMENTED
-#endif
-
-/*//////////////////////////
-// MATRIX
-//////////////////////////*/
-
-void vg_matrix_identity(float *m)
-{
-	*(vgMatrix*)m = (vgMatrix) { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
-}
-
-void vg_matrix_translate(float *m, float x, float y)
-{
-	m[2] += x * m[0] + y * m[1];
-	m[5] += x * m[3] + y * m[4];
-}
-
-void vg_matrix_rotate(float *m, float a)
-{
-	float cs = cosf(a);
-	float sn = sinf(a);
-	float xx = m[0];
-	float xy = m[1];
-	float yx = m[3];
-	float yy = m[4];
-	m[0] = xx *  cs + xy * sn;
-	m[1] = xx * -sn + xy * cs;
-	m[3] = yx *  cs + yy * sn;
-	m[4] = yx * -sn + yy * cs;
-}
-
-void vg_matrix_scale(float *m, float x, float y)
-{
-	m[0] *= x;
-	m[1] *= y;
-	m[3] *= x;
-	m[4] *= y;
-}
-
-void vg_matrix_multiply(float *m, float *a)
-{
-	float xx = m[0];
-	float xy = m[1];
-	float xt = m[2];
-	float yx = m[3];
-	float yy = m[4];
-	float yt = m[5];
-
-	m[0] = xx * a[0] + xy * a[1];
-	m[1] = xx * a[3] + xy * a[4];
-
-	m[3] = yx * a[0] + yy * a[1];
-	m[4] = yx * a[3] + yy * a[4];
-
-	m[2] = xt + a[2];
-	m[5] = yt + a[5];
-}
-
-int vg_matrix_inverse(float *m, float *a)
-{
-	float i, d;
-	d = a[0] * a[4] - a[1] * a[3];
-	if (d > -1e-6f && d < 1e-6f) {
-		vg_matrix_identity(m);
-		return 0;
-	}
-	i = 1.0f / d;
-	m[0] =  a[4] * i;
-	m[1] = -a[1] * i;
-	m[2] = (a[1] * a[5] - a[4] * a[2]) * i;
-	m[3] = -a[3] * i;
-	m[4] =  a[0] * i;
-	m[5] = (a[3] * a[2] - a[0] * a[5]) * i;
-	return 1;
-}
-
-void vg_matrix_lerp(float *m, float *a, float t)
-{
-	m[0] = m[0] * (1.0f - t) + a[0] * t;
-	m[1] = m[1] * (1.0f - t) + a[1] * t;
-	m[2] = m[2] * (1.0f - t) + a[2] * t;
-	m[3] = m[3] * (1.0f - t) + a[3] * t;
-	m[4] = m[4] * (1.0f - t) + a[4] * t;
-	m[5] = m[5] * (1.0f - t) + a[5] * t;
-}
-
-void vg_matrix_project(float *m, float *x, float *y)
-{
-	float sx = *x;
-	float sy = *y;
-	*x = sx * m[0] + sy * m[1] + m[2];
-	*y = sx * m[3] + sy * m[4] + m[5];
-}
-
-void vg_matrix_unproject(float *m, float *x, float *y)
-{
-	vgMatrix inv;
-	vg_matrix_inverse(inv.v, m);
-	vg_matrix_project(inv.v, x, y);
-}
-
-void vg_matrix_projectn(float *m, float *x, float *y)
-{
-	float sx = *x;
-	float sy = *y;
-	*x = sx * m[0] + sy * m[1];
-	*y = sx * m[3] + sy * m[4];
-}
-
-void vg_matrix_unprojectn(float *m, float *x, float *y)
-{
-	vgMatrix inv;
-	vg_matrix_inverse(inv.v, m);
-	vg_matrix_projectn(inv.v, x, y);
-}
-
-void vg_matrix_pan(float *m, float x, float y, float speed)
-{
-	x *= speed; y *= speed;
-	if (x == 0.0f && y == 0.0f) return;
-	vg_matrix_unprojectn(m, &x, &y);
-	vg_matrix_translate(m, x, y);
-}
-
-void vg_matrix_zoom(float *m, float x, float y, float zoom)
-{
-	if (zoom == 0.0f) return;
-	float factor = powf(1.1f, zoom);
-	vg_matrix_unproject(m, &x, &y);
-	vg_matrix_translate(m, x, y);
-	vg_matrix_scale(m, factor, factor);
-	vg_matrix_translate(m, -x, -y);
-}
-
-/*//////////////////////////
-// UNICODE
-//////////////////////////*/
-
-// Copyright (c) 2008-2010 Bjoern Hoehrmann <bjoern@hoehrmann.de>
-// See http://bjoern.hoehrmann.de/utf-8/decoder/dfa/ for details.
-
-#define VG_UTF8_ACCEPT 0
-#define VG_UTF8_REJECT 12
-
-static unsigned vg_decode_utf8(unsigned* state, unsigned* codep, unsigned byte)
-{
-	static const unsigned char utf8d[] = {
-		// The first part of the table maps bytes to character classes that
-		// to reduce the size of the transition table and create bitmasks.
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,  9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-		7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-		8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,  2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
-		10,3,3,3,3,3,3,3,3,3,3,3,3,4,3,3, 11,6,6,6,5,8,8,8,8,8,8,8,8,8,8,8,
-
-		// The second part is a transition table that maps a combination
-		// of a state of the automaton and a character class to a state.
-		0,12,24,36,60,96,84,12,12,12,48,72, 12,12,12,12,12,12,12,12,12,12,12,12,
-		12, 0,12,12,12,12,12, 0,12, 0,12,12, 12,24,12,12,12,12,12,24,12,24,12,12,
-		12,12,12,12,12,12,12,24,12,12,12,12, 12,24,12,12,12,12,12,12,12,24,12,12,
-		12,12,12,12,12,12,12,36,12,36,12,12, 12,36,12,12,12,12,12,36,12,36,12,12,
-		12,36,12,12,12,12,12,12,12,12,12,12,
-    };
-
-	unsigned type = utf8d[byte];
-    *codep = (*state != VG_UTF8_ACCEPT) ?
-		(byte & 0x3fu) | (*codep << 6) :
-		(0xff >> type) & (byte);
-
-	*state = utf8d[256 + *state + type];
-	return *state;
-}
-
-/*//////////////////////////
-// TTF FONT
-//////////////////////////*/
-
-// thanks to stb_truetype.h for the reference implementation
-
-typedef struct vgttEntry vgttEntry;
-typedef struct vgttGlyph vgttGlyph;
-typedef struct vgttIter  vgttIter;
-
-struct vgttEntry {
-	unsigned tag;
-	unsigned checksum;
-	unsigned offset;
-	unsigned length;
-};
-
-struct vgttGlyph {
-	int code;
-	int index;
-	int offset;
-	int ncont;
-	int xmin;
-	int ymin;
-	int xmax;
-	int ymax;
-	float width;
-	float lsb;
-	vgttGlyph *next;
-};
-
-struct vgFont {
-	void *data;
-	unsigned size;
-	unsigned version;
-	unsigned num_tables;
-	unsigned search_range;
-	unsigned entry_selector;
-	unsigned range_shift;
-	vgttEntry head;
-	vgttEntry maxp;
-	vgttEntry loca;
-	vgttEntry glyf;
-	vgttEntry cmap;
-	vgttEntry hhea;
-	vgttEntry os_2;
-	vgttEntry hmtx;
-	vgttEntry gpos;
-	vgttEntry kern;
-	vgttEntry cff;
-	vgttGlyph *glyphs[256];
-};
-
-struct vgttIter {
-	vgFont *font;
-	float size;
-	float base_x;
-	float base_y;
-	float curr_x;
-	float curr_y;
-	float next_x;
-	float next_y;
-	unsigned prev_code;
-	unsigned curr_code;
-	vgttGlyph *prev_glyph;
-	vgttGlyph *curr_glyph;
-	const char *str;
-	const char *end;
-};
-
-#ifdef VG_BIG_ENDIAN
-#define TTF_SWAP_U16(V) (V)
-#define TTF_SWAP_U32(V) (V)
-#else
-#define TTF_SWAP_U16(V) (ttf_font_swap_u16(V))
-#define TTF_SWAP_U32(V) (ttf_font_swap_u32(V))
-static unsigned short ttf_font_swap_u16(unsigned short v) { return ((v >> 8) & 0xFF) | (((v) & 0xFF) << 8); }
-static unsigned int   ttf_font_swap_u32(unsigned int   v) { return (((v) >> 24) & 0xFF) | (((v) << 8) & 0xFF0000) | (((v) >> 8) & 0xFF00) | (((v) << 24) & 0xFF000000); }
-#endif
-
-#define TTF_INDEX(TTF, BASE, OFFSET)       ((char*)(TTF)->data + (BASE) + (OFFSET))
-#define TTF_CHECK(TTF, BASE, OFFSET, TYPE) ((BASE)+(OFFSET)+sizeof(TYPE) <= (TTF)->size)
-
-#define TTF_VAL(TTF, BASE, OFFSET, TYPE)   (TTF_CHECK(TTF, BASE, OFFSET, TYPE) ? *(TYPE*)TTF_INDEX(TTF, BASE, OFFSET) : (TYPE)0)
-#define TTF_U8(TTF, BASE, OFFSET)          (TTF_VAL(TTF, BASE, OFFSET, unsigned char))
-#define TTF_U16(TTF, BASE, OFFSET)         (TTF_SWAP_U16(TTF_VAL(TTF, BASE, OFFSET, unsigned short)))
-#define TTF_U32(TTF, BASE, OFFSET)         (TTF_SWAP_U32(TTF_VAL(TTF, BASE, OFFSET, unsigned int)))
-#define TTF_I8(TTF, BASE, OFFSET)          ((signed char)TTF_U8(TTF, BASE, OFFSET))
-#define TTF_I16(TTF, BASE, OFFSET)         ((signed short)TTF_U16(TTF, BASE, OFFSET))
-#define TTF_I32(TTF, BASE, OFFSET)         ((signed int)TTF_U32(TTF, BASE, OFFSET))
-#define TTF_F32(TTF, BASE, OFFSET)         ((TTF_U16(TTF, BASE, OFFSET) / 4.0f) + TTF_U16(TTF, BASE, (OFFSET)+2))
-
-#define TTF_TAG(A,B,C,D) (((D)<<0)|((C)<<8)|((B)<<16)|((A)<<24))
-
-void vg_font_init(vgFont *ttf, void *data, int size)
-{
-	vgttEntry entry;
-	unsigned base, i;
-
-	memset(ttf, 0, sizeof(vgFont));
-	ttf->data = (char*)data;
-	ttf->size = size;
-
-	base = 0;
-	ttf->version        = TTF_U32(ttf, base, 0);
-	ttf->num_tables     = TTF_U16(ttf, base, 4);
-	ttf->search_range   = TTF_U16(ttf, base, 6);
-	ttf->entry_selector = TTF_U16(ttf, base, 8);
-	ttf->range_shift    = TTF_U16(ttf, base, 10);
-
-	base = 12;
-	for (i = 0; i < ttf->num_tables; i++) {
-		entry.tag      = TTF_U32(ttf, base, 0);
-		entry.checksum = TTF_U32(ttf, base, 4);
-		entry.offset   = TTF_U32(ttf, base, 8);
-		entry.length   = TTF_U32(ttf, base, 12);
-
-		switch (entry.tag) {
-		case TTF_TAG('h','e','a','d'): ttf->head = entry; break;
-		case TTF_TAG('m','a','x','p'): ttf->maxp = entry; break;
-		case TTF_TAG('l','o','c','a'): ttf->loca = entry; break;
-		case TTF_TAG('g','l','y','f'): ttf->glyf = entry; break;
-		case TTF_TAG('c','m','a','p'): ttf->cmap = entry; break;
-		case TTF_TAG('h','h','e','a'): ttf->hhea = entry; break;
-		case TTF_TAG('o','s','/','2'): ttf->os_2 = entry; break;
-		case TTF_TAG('h','m','t','x'): ttf->hmtx = entry; break;
-		case TTF_TAG('G','P','O','S'): ttf->gpos = entry; break;
-		case TTF_TAG('k','e','r','n'): ttf->gpos = entry; break;
-		case TTF_TAG('C','F','F',' '): ttf->cff  = entry; break;
-		}
-
-		base += 16;
-	}
-}
-
-vgFont* vg_font_load(const char *filename)
-{
-	int size; void *data;
-	vgFont *font;
-	FILE *file;
-
-	file = fopen(filename, "r");
-	if (!file) return 0;
-	fseek(file, 0, SEEK_END);
-	size = ftell(file);
-	fseek(file, 0, SEEK_SET);
-
-	font = malloc(sizeof(vgFont) + size);
-	data = (void*)&font[1];
-
-	fread(data, 1, size, file);
-	fclose(file);
-
-	vg_font_init(font, data, size);
-	return font;
-}
-
-vgFont* vg_font_loadp(void *data, int size)
-{
-	vgFont *font;
-	font = malloc(sizeof(vgFont));
-	vg_font_init(font, data, size);
-	return font;
-}
-
-vgFont* vg_font_default()
-{
-	// TODO: embed small default font?
-	return 0;
-}
-
-static int vg_font_glyph_index(vgFont *ttf, int c)
-{
-	int version, ntables, platformid, encodingid;
-	int oec, osc, odt, oro, ogi, ro, sc, ec, dt;
-	int segcount, range, selector, shift;
-	int base, format, length, offset;
-	int lang, index, i;
-
-	if (c < 0) return 0;
-
-	base = ttf->cmap.offset;
-	version = TTF_U16(ttf, base, 0);
-	ntables = TTF_U16(ttf, base, 2);
-
-	base += 4;
-	platformid = TTF_U16(ttf, base, 0);
-	encodingid = TTF_U16(ttf, base, 2);
-	offset = TTF_U32(ttf, base, 4);
-
-	base = ttf->cmap.offset + offset;
-	format = TTF_U16(ttf, base, 0);
-	length = TTF_U16(ttf, base, 2);
-
-	index = 0;
-
-	if (format == 4) {
-		lang     = TTF_U16(ttf, base, 4);
- 		segcount = TTF_U16(ttf, base, 6) / 2;
-		range    = TTF_U16(ttf, base, 8);
-		selector = TTF_U16(ttf, base, 10);
-		shift    = TTF_U16(ttf, base, 12);
-
-		oec = base + 14;
-		osc = oec + segcount * 2 + 2;
-		odt = osc + segcount * 2;
-		oro = odt + segcount * 2;
-		ogi = oro + segcount * 2;
-
-		for (i = 0; i < segcount; i++) {
-			sc = TTF_U16(ttf, osc, i * 2);
-			ec = TTF_U16(ttf, oec, i * 2);
-			dt = TTF_I16(ttf, odt, i * 2);
-			if (c <= ec) {
-				if (c >= sc) {
-					ro = TTF_U16(ttf, oro, i * 2);
-					if (ro) {
-						index = TTF_U16(ttf, oro, (i + ro / 2 + (c - sc)) * 2);
-						if (index) index += dt;
-					} else {
-						index = (c + dt) % 65536;
-					}
-				} else {
-					return 0;
-				}
-				break;
-			}
-		}
-	} else
-	if (format == 0) {
-		if (c > 255) return 0;
-		lang = TTF_U8(ttf, base, 4);
-		index = TTF_U8(ttf, base, 6 + c);
-	}
-
-	return index;
-}
-
-static int vg_font_glyph_offset(vgFont *ttf, int index)
-{
-	int offset, wide;
-	wide = TTF_U16(ttf, ttf->head.offset, 50);
-	if (wide)
-		 offset = TTF_U32(ttf, ttf->loca.offset, index * 4);
-	else offset = TTF_U16(ttf, ttf->loca.offset, index * 2) * 2;
-	return ttf->glyf.offset + offset;
-}
-
-static vgttGlyph* vg_font_glyph(vgFont *ttf, int c)
-{
-	int hash, index, offset;
-	vgttGlyph *glyph;
-
-	hash = c & 0xFF;
-	glyph = ttf->glyphs[hash];
-	while (glyph) {
-		if (glyph->code == c)
-			return glyph;
-		glyph = glyph->next;
-	}
-
-	index = vg_font_glyph_index(ttf, c);
-	if (index == 0) return 0;
-
-	offset = vg_font_glyph_offset(ttf, index);
-	if (offset == 0) return 0;
-
-	// TODO: batch alloc
-	glyph = calloc(1, sizeof(vgttGlyph));
-	glyph->code = c;
-	glyph->index = index;
-	glyph->offset = offset;
-	glyph->ncont = TTF_I16(ttf, glyph->offset, 0);
-	glyph->xmin  = TTF_I16(ttf, glyph->offset, 2);
-	glyph->ymin  = TTF_I16(ttf, glyph->offset, 4);
-	glyph->xmax  = TTF_I16(ttf, glyph->offset, 6);
-	glyph->ymax  = TTF_I16(ttf, glyph->offset, 8);
-
-	int nmetrics = TTF_U16(ttf, ttf->hhea.offset, 34);
-	if (glyph->index < nmetrics) {
-		glyph->width = TTF_I16(ttf, ttf->hmtx.offset, 4 * glyph->index) / 2000.0f;
-		glyph->lsb   = TTF_I16(ttf, ttf->hmtx.offset, 4 * glyph->index + 2) / 2000.0f;
-	} else {
-		glyph->width = TTF_I16(ttf, ttf->hmtx.offset, 4 * (nmetrics - 1)) / 2000.0f;
-		glyph->lsb   = TTF_I16(ttf, ttf->hmtx.offset, 4 * nmetrics + 2 * (glyph->index - nmetrics)) / 2000.0f;
-	}
-
-done:
-	glyph->next = ttf->glyphs[hash];
-	ttf->glyphs[hash] = glyph;
-	return glyph;
-}
-
-static int vg_font_glyph_coverage(vgFont *ttf, int ocoverage, int glyph)
-{
-	int format = TTF_U16(ttf, ocoverage, 0);
-	switch (format) {
-	case 1: {
-		int nglyph = TTF_U16(ttf, ocoverage, 2);
-		int l = 0, r = nglyph - 1, m;
-		int straw, needle = glyph;
-		while (l <= r) {
-			m = (l + r) >> 1;
-			straw = TTF_U16(ttf, ocoverage, 4 + 2 * m);
-			if      (needle < straw) r = m - 1;
-			else if (needle > straw) l = m + 1;
-			else     return m;
-		}
-		break; }
-	case 2: {
-		int nrange = TTF_U16(ttf, ocoverage, 2);
-		int orange = ocoverage + 4;
-		int l = 0, r = nrange - 1, m;
-		int orecord, strawa, strawb, needle = glyph;
-		while (l <= r) {
-			m = (l + r) >> 1;
-			orecord = orange + 6 * m;
-			strawa = TTF_U16(ttf, orecord, 0);
-			strawb = TTF_U16(ttf, orecord, 2);
-			if      (needle < strawa) r = m - 1;
-			else if (needle > strawb) l = m + 1;
-			else    return TTF_U16(ttf, orecord, 4) + glyph - strawa;
-		}
-		break; }
-	default:
-		return -1;
-	}
-	return -1;
-}
-
-static float vg_font_glyph_kern_gpos(vgFont *ttf, int g1, int g2)
-{
-	if (!ttf->gpos.tag) return 0;
-
-	int odata = ttf->gpos.offset;
-	if (TTF_U16(ttf, odata, 0) != 1) return 0; // major version 1
-	if (TTF_U16(ttf, odata, 2) != 0) return 0; // minor version 0
-
-	int olist = TTF_U16(ttf, odata, 8) + odata;
-	int nlist = TTF_U16(ttf, olist, 0);
-
-	for (int i = 0; i < nlist; i++) {
-		int olookup = TTF_U16(ttf, olist, 2 + 2 * i) + olist;
-		int tlookup = TTF_U16(ttf, olookup, 0);
-		int nlookup = TTF_U16(ttf, olookup, 4);
-		int ooffset = olookup + 6;
-		if (tlookup != 2) continue; // pair adjustment positioning subtable
-
-		for (int j = 0; j < nlookup; j++) {
-			int otable = TTF_U16(ttf, ooffset, 2 * j) + olookup;
-			int format = TTF_U16(ttf, otable, 0);
-			int ocoverage = TTF_U16(ttf, otable, 2) + otable;
-			int icoverage = vg_font_glyph_coverage(ttf, ocoverage, g1);
-			if (icoverage == -1) continue;
-
-			switch (format) {
-			case 1: {
-				// TODO:
-				return 0; }
-			case 2: {
-				// TODO:
-				return 0; }
-			default:
-				return 0; // unsupported
-			}
-		}
-	}
-
-	return 0;
-}
-
-static float vg_font_glyph_kern_info(vgFont *ttf, int g1, int g2)
-{
-	unsigned needle, straw;
-	int l, r, m;
-
-	if (!ttf->kern.tag) return 0;
-	if (TTF_U16(ttf, ttf->kern.offset, 2) < 1) return 0;
-	if (TTF_U16(ttf, ttf->kern.offset, 8) != 1) return 0;
-
-	l = 0;
-	r = TTF_U16(ttf, ttf->kern.offset, 10) - 1;
-	needle = g1 << 16 | g2;
-
-	while (l <= r) {
-		m = (l + r) >> 1;
-		straw = TTF_U32(ttf, ttf->kern.offset, 18 + (m * 6));
-		if      (needle < straw) r = m - 1;
-		else if (needle > straw) l = m + 1;
-		else return TTF_I16(ttf, ttf->kern.offset, 22 + (m * 6)) / 2000.0f;
-	}
-
-	return 0;
-}
-
-static float vg_font_glyph_kern(vgFont *ttf, int g1, int g2)
-{
-	// TODO: cache?
-	if      (ttf->gpos.tag) return vg_font_glyph_kern_gpos(ttf, g1, g2);
-	else if (ttf->kern.tag) return vg_font_glyph_kern_info(ttf, g1, g2);
-	else                    return 0;
-}
-
-static void vg_font_draw_glyph(vgFont *ttf, float x, float y, float size, int oglyph);
-
-static void vg_font_draw_glyph_contour(vgFont *ttf, float x, float y, float size, int oglyph)
-{
-	int ocont, ncont, npnts, oinst, ninst, oflag, ocoordx, ocoordy, oncurve;
-	int flag, ix, iy, iw, nx, ny, dx, dy, i, c, r;
-	int c0, c1, move, end;
-	vgPoint p0, p1, pc, ps;
-
-	ncont = TTF_I16(ttf, oglyph, 0);
-	if (ncont <= 0) return;
-
-	ocont = oglyph + 10;
-	npnts = TTF_U16(ttf, ocont, (ncont - 1) * 2) + 1;
-	ninst = TTF_U16(ttf, ocont, ncont * 2);
-	oinst = ocont + ncont * 2 + 2;
-	oflag = oinst + ninst;
-	ix = iw = 0;
-
-	// find coord offsets
-	for (i = 0; i < npnts; iw++) {
-		flag = TTF_U8(ttf, oflag, iw);
-
-		if (flag & 0x08 /* REPEAT */) {
-			iw++;
-			r = TTF_U8(ttf, oflag, iw) + 1;
-		} else {
-			r = 1;
-		}
-
-		while (r--) {
-			if (flag & 0x02 /* X_SHORT_VECTOR */) {
-				ix += 1;
-			} else
-			if (!(flag & 0x10 /* X_IS_SAME */)) {
-				ix += 2;
-			}
-			i++;
-		}
-	}
-
-	ocoordx = oflag + iw;
-	ocoordy = ocoordx + ix;
-
-	p0.x = p0.y = ps.x = 0;
-	p1.x = p1.y = ps.y = 0;
-	ix = iy = iw = 0;
-	nx = ny = 0;
-	i = 0;
-
-	// emit contours
-	for (c = i = 0; c < ncont; c++) {
-		c0 = c1 = 0;
-		end = TTF_U16(ttf, ocont, c * 2);
-		move = 1;
-
-		for (; i <= end; iw++) {
-			flag = TTF_U8(ttf, oflag, iw);
-			oncurve = (flag & 0x01);
-
-			if (flag & 0x08 /* REPEAT */) {
-				iw++;
-				r = TTF_U8(ttf, oflag, iw) + 1;
-			} else {
-				r = 1;
-			}
-
-			while (r--) {
-				if (flag & 0x02 /* X_SHORT_VECTOR */) {
-					dx = TTF_U8(ttf, ocoordx, ix);
-					if (!(flag & 0x10 /* X_IS_POSITIVE */))
-							dx = -dx;
-					ix += 1;
-				} else
-				if (flag & 0x10 /* X_IS_SAME */) {
-					dx = 0;
-				} else {
-					dx = TTF_I16(ttf, ocoordx, ix);
-					ix += 2;
-				}
-
-				if (flag & 0x04 /* Y_SHORT_VECTOR */) {
-					dy = TTF_U8(ttf, ocoordy, iy);
-					if (!(flag & 0x20 /* Y_IS_POSITIVE */))
-						dy = -dy;
-					iy += 1;
-				} else
-				if (flag & 0x20 /* Y_IS_SAME */) {
-					dy = 0;
-				} else {
-					dy = TTF_I16(ttf, ocoordy, iy);
-					iy += 2;
-				}
-
-				nx += dx;
-				ny += dy;
-
-				c0 = c1;
-				p0 = p1;
-				p1.x = nx / 2000.0f;
-				p1.y = 1.0f - ny / 2000.0f;
-				p1.x = p1.x * size + x;
-				p1.y = p1.y * size + y;
-				c1 = oncurve == 0;
-
-				if (move) {
-					move = 0;
-					ps = p1;
-					vg_moveto(p1.x, p1.y);
-				} else {
-					if (c1) {
-						if (c0) {
-							pc.x = (p0.x + p1.x) * 0.5f;
-							pc.y = (p0.y + p1.y) * 0.5f;
-							vg_curveto(p0.x, p0.y, pc.x, pc.y);
-						}
-					} else {
-						if (c0) {
-							vg_curveto(p0.x, p0.y, p1.x, p1.y);
-						} else {
-							vg_lineto(p1.x, p1.y);
-						}
-					}
-				}
-				i++;
-			}
-		}
-
-		if (c1) {
-			vg_curveto(p1.x, p1.y, ps.x, ps.y);
-		} else {
-			vg_lineto(ps.x, ps.y);
-		}
-	}
-}
-
-static void vg_font_draw_glyph_compound(vgFont *ttf, float x, float y, float size, int oglyph) {
-	int ncont, ocomp, more, flags, next;
-
-	ncont = TTF_I16(ttf, oglyph, 0);
-	if (ncont >= 0) return;
-
-	ocomp = oglyph + 10;
-// 	flags = TTF_U16(ttf, ocomp, 0);
-// 	next  = TTF_U16(ttf, ocomp, 2);
-// 	more  = 1;
-
-// 	while (more) {
-// 		// TODO: transform
-// 		vg_font_draw_glyph(ttf, x, y, size, vg_font_glyph_offset(ttf, next));
-// 		// TODO: more
-// 		more = 0;
-// 	}
-	do {
-		flags = TTF_U16(ttf, ocomp, 0);
-		next  = TTF_U16(ttf, ocomp, 2);
-// 		if (more)
-			vg_font_draw_glyph(ttf, x, y, size, vg_font_glyph_offset(ttf, next));
-// 		ocomp = next+10;
-		ocomp += 4;
-		if (flags & 0x0001)
-			ocomp += 4;
-		else
-			ocomp += 2;
-	  if (flags & 0x0008)
-	  	ocomp += 2;
-	  else if (flags & 0x0040)
-	  	ocomp += 4;
-	  else if (flags & 0x0080)
-	 	 ocomp += 8;
-		more++;
-	} while (flags & 0x0020);
-}
-
-static void vg_font_draw_glyph(vgFont *ttf, float x, float y, float size, int oglyph) {
-	// TODO: cache?
-	int ncont = TTF_I16(ttf, oglyph, 0);
-	if (ncont < 0) vg_font_draw_glyph_compound(ttf, x, y, size, oglyph);
-	else           vg_font_draw_glyph_contour(ttf, x, y, size, oglyph);
-}
-
-static void vg_font_begin(vgttIter *iter, vgFont *ttf, float x, float y, float size, const char *str, const char *end)
-{
-	iter->font = ttf;
-	iter->size = size;
-	iter->base_x = iter->curr_x = iter->next_x = x;
-	iter->base_y = iter->curr_y = iter->next_y = y;
-	iter->prev_glyph = iter->curr_glyph = 0;
-	iter->prev_code = iter->curr_code = 0;
-	iter->str = str;
-	iter->end = end;
-}
-
-static int vg_font_next(vgttIter *iter)
-{
-	const char *str = iter->str;
-	const char *end = iter->end;
-	unsigned state = 0;
-	unsigned code = 0;
-	vgttGlyph *glyph;
-
-	if (end ? str == end : !str[0])
-		return 0;
-
-	for (; end ? str != end : str[0]; str++) {
-		if (vg_decode_utf8(&state, &code, *(const unsigned char*)str))
-			continue;
-
-		if (code == '\n') {
-			iter->curr_x = iter->next_x = iter->base_x;
-			iter->curr_y = iter->next_y;
-			iter->next_y += iter->size * 0.65f; // TODO: valign
-			iter->prev_code = 0;
-			iter->prev_glyph = 0;
-			continue;
-		}
-
-		// TODO: font fallbacks
-		glyph = vg_font_glyph(iter->font, code);
-
-		if (glyph && iter->prev_glyph)
-			iter->next_x += vg_font_glyph_kern(iter->font, iter->prev_glyph->index, glyph->index);
-
-		iter->curr_x = iter->next_x;
-		iter->curr_y = iter->next_y;
-		iter->prev_code = iter->curr_code;
-		iter->prev_glyph = iter->curr_glyph;
-		iter->curr_code = code;
-		iter->curr_glyph = glyph;
-
-		if (glyph)
-			iter->next_x += glyph->width * iter->size;
-
-		str++;
-		break;
-	}
-
-	iter->str = str;
-	return 1;
-}
-
-void vg_font_draw_char(vgFont *ttf, float x, float y, float size, int c)
-{
-	vgttGlyph *glyph;
-	vg_path();
-	glyph = vg_font_glyph(ttf, c);
-	if (glyph == 0) return;
-	vg_font_draw_glyph(ttf, x, y, size, glyph->offset);
-}
-
-float vg_font_measure_text(vgFont *ttf, float size, const char *str, const char *end)
-{
-	vgttIter iter; float w = 0;
-	vg_font_begin(&iter, ttf, 0, 0, size, str, end);
-	while (vg_font_next(&iter))
-		w = fmaxf(w, iter.next_x);
-	return w;
-}
-
-void vg_font_draw_text(vgFont *ttf, float x, float y, float size, const char *str, const char *end)
-{
-	vgttIter iter;
-	vg_path();
-	vg_font_begin(&iter, ttf, x, y, size, str, end);
-	while (vg_font_next(&iter))
-		if (iter.curr_glyph && iter.curr_code != ' ')
-			vg_font_draw_glyph(ttf, iter.curr_x, iter.curr_y, size, iter.curr_glyph->offset);
-}
-
-/*//////////////////////////
-// COLOR
-//////////////////////////*/
-
-vgColor vg_color_hsv(float h, float s, float v)
-{
-	float r, g, b, f, p, q, t; int i;
-	if (h < 0) h = -h;
-	r = 0.0f, g = 0.0f, b = 0.0f;
-	i = (int)(h * 6);
-	f = h * 6 - i;
-	p = v * (1 - s);
-	q = v * (1 - f * s);
-	t = v * (1 - (1 - f) * s);
-	switch (i % 6) {
-	case 0: r = v, g = t, b = p; break;
-	case 1: r = q, g = v, b = p; break;
-	case 2: r = p, g = v, b = t; break;
-	case 3: r = p, g = q, b = v; break;
-	case 4: r = t, g = p, b = v; break;
-	case 5: r = v, g = p, b = q; break;
-	}
-	return VG_RGBF(r, g, b);
-}
-
-vgColor vg_color_blend(vgColor src, vgColor dst)
-{
-	vgColor a = (src >> 24) + 1;
-	vgColor drb = dst & 0xFF00FF;
-	vgColor dg = dst & 0xFF00;
-	return ((((((src & 0xFF00FF) - drb) * a) >> 8) + drb) & 0xFF00FF) | ((((((src & 0xFF00) - dg) * a) >> 8) + dg) & 0xFF00) | 0xFF000000;
-}
-
-vgColor vg_color_lerp(vgColor src, vgColor dst, vgColor a)
-{
-	return ((((VG_R(src) - VG_R(dst)) * a) >> 8) + VG_R(dst)) << 0  |
-	       ((((VG_G(src) - VG_G(dst)) * a) >> 8) + VG_G(dst)) << 8  |
-	       ((((VG_B(src) - VG_B(dst)) * a) >> 8) + VG_B(dst)) << 16 |
-	       ((((VG_A(src) - VG_A(dst)) * a) >> 8) + VG_A(dst)) << 24;
-}
-
-vgColor vg_color_lerpf(vgColor src, vgColor dst, float a)
-{
-	return vg_color_lerp(src, dst, (vgColor)(a * 255));
-}
-
-/*//////////////////////////
-// COMMANDS
-//////////////////////////*/
-
-void vg_eval(vgCommand *cmd) {
-	while (1) {
-		switch (cmd->type) {
-		case VG_CMD_MOVETO:
-			vg_moveto(cmd->moveto.coords[0], cmd->moveto.coords[1]);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->moveto));
-			break;
-		case VG_CMD_LINETO:
-			vg_lineto(cmd->lineto.coords[0], cmd->lineto.coords[1]);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->lineto));
-			break;
-		case VG_CMD_CURVETO:
-			vg_curveto(cmd->curveto.coords[0], cmd->curveto.coords[1], cmd->curveto.coords[2], cmd->curveto.coords[3]);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->curveto));
-			break;
-		case VG_CMD_CUBICTO:
-			vg_cubicto(cmd->cubicto.coords[0], cmd->cubicto.coords[1], cmd->cubicto.coords[2], cmd->cubicto.coords[3], cmd->cubicto.coords[4], cmd->cubicto.coords[5]);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->cubicto));
-			break;
-		case VG_CMD_ALPHA:
-			vg_alpha(cmd->alpha.value);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->alpha));
-			break;
-		case VG_CMD_FILL:
-			vg_fill(cmd->fill.color);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->fill));
-			break;
-		case VG_CMD_STROKE:
-			vg_stroke(cmd->stroke.color, cmd->stroke.width);
-			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->stroke));
-			break;
-		default: return;
-		}
-	}
-}
-
-#endif
-#endif
+/*////////////////////////////////////////////////////
+// Public domain, vector-graphics library.
+//////////////////////////////////////////////////////
+
+CREATOR: Josian Marriott (josianjames@gmail.com)
+
+LICENSE: This software is dual-licensed to the public domain and under the following
+license: you are granted a perpetual, irrevocable license to copy, modify,
+publish, and distribute this file as you see fit.
+
+////////////////////////////////////////////////////*/
+
+#ifndef VGL_H
+#define VGL_H
+
+#ifndef VGL_API
+#define VGL_API extern
+#endif
+
+/*//////////////////////////
+// DRIVER
+//////////////////////////*/
+
+#define VGL_OPENGL  (1)
+#define VGL_VULKAN  (2) // not implemented
+#define VGL_DIRECTX (3) // not implemented
+
+#ifndef VGL_DRIVER
+#define VGL_DRIVER VGL_OPENGL
+#endif
+
+#ifndef VGL_COMPUTE
+#define VGL_COMPUTE (0) // rasterize tile lists with compute shaders, requires OpenGL 4.3
+#endif
+
+#ifndef VGL_TILE_LISTS
+#define VGL_TILE_LISTS (VGL_COMPUTE) // composite every fill of a tile in one fragment pass
+#endif
+
+#ifndef VGL_GPU_BINNING
+#define VGL_GPU_BINNING (0) // bin contours into tiles with compute shaders, requires OpenGL 4.3
+#endif
+
+#ifndef VGL_VARIANTS
+#define VGL_VARIANTS (!VGL_TILE_LISTS && !VGL_GPU_BINNING) // specialized programs per fill class
+#endif
+
+#if VGL_VARIANTS && VGL_TILE_LISTS
+#error "VGL_VARIANTS can not be combined with VGL_TILE_LISTS"
+#endif
+
+#if VGL_COMPUTE && !VGL_TILE_LISTS
+#error "VGL_COMPUTE requires VGL_TILE_LISTS"
+#endif
+
+#if VGL_GPU_BINNING && (VGL_TILE_LISTS || VGL_VARIANTS)
+#error "VGL_GPU_BINNING can not be combined with VGL_TILE_LISTS or VGL_VARIANTS"
+#endif
+
+#ifndef VGL_EDGE_SLOPES
+#define VGL_EDGE_SLOPES (0) // upload edges with their slopes, sorted by top, in place of strips
+#endif
+
+#if VGL_EDGE_SLOPES && VGL_GPU_BINNING
+#error "VGL_EDGE_SLOPES can not be combined with VGL_GPU_BINNING"
+#endif
+
+#ifndef VGL_HAIRLINE_WIDTH
+#define VGL_HAIRLINE_WIDTH (2.0f) // device width up to which strokes are drawn as lines, at most 3.9
+#endif
+
+/*//////////////////////////
+// API
+//////////////////////////*/
+
+#define VG_NEGATIVE     (-1)
+#define VG_POSITIVE     (1)
+#define VG_NONZERO      (2)
+#define VG_EVENODD      (3)
+#define VG_INTERSECTION (4)
+
+#define VG_JOIN_MITER   (0)
+#define VG_JOIN_ROUND   (1)
+#define VG_JOIN_BEVEL   (2)
+
+#define VG_CAP_BUTT     (0)
+#define VG_CAP_ROUND    (1)
+#define VG_CAP_SQUARE   (2)
+
+#define VG_ITEM_FLAT    (0)
+#define VG_ITEM_LINEAR  (1)
+#define VG_ITEM_RADIAL  (2)
+#define VG_ITEM_BOX     (3)
+
+typedef unsigned vgColor;
+typedef struct   vgFillItem vgFillItem;
+typedef struct   vgPoint  vgPoint;
+typedef union    vgMatrix vgMatrix;
+typedef struct   vgFont   vgFont;
+typedef struct   vgShape  vgShape;
+typedef struct   vgScene  vgScene;
+typedef struct   vgImage  vgImage;
+
+VGL_API void  vg_init       ();
+VGL_API void  vg_begin      ();
+VGL_API void  vg_flush      ();
+VGL_API void  vg_clear      (unsigned color);
+VGL_API void  vg_end        ();
+
+VGL_API void  vg_path       ();
+VGL_API void  vg_moveto     (float x, float y);
+VGL_API void  vg_lineto     (float x, float y);
+VGL_API void  vg_curveto    (float x0, float y0, float x1, float y1);
+VGL_API void  vg_cubicto    (float x0, float y0, float x1, float y1, float x2, float y2);
+VGL_API void  vg_arcto      (float x0, float y0, float x1, float y1, float radius);
+VGL_API void  vg_line       (float x0, float y0, float x1, float y1);
+VGL_API void  vg_vline      (float x, float y0, float y1);
+VGL_API void  vg_hline      (float y, float x0, float x1);
+VGL_API void  vg_arc        (float x, float y, float a0, float a1, float r);
+VGL_API void  vg_circle     (float x, float y, float r);
+VGL_API void  vg_ellipse    (float x, float y, float rx, float ry);
+VGL_API void  vg_rect       (float x, float y, float w, float h);
+VGL_API void  vg_rectr      (float x, float y, float w, float h, float rx, float ry);
+VGL_API void  vg_polyline_decimated (const float *xs, const float *ys, int n);
+VGL_API void  vg_char       (float x, float y, float size, int c);
+VGL_API void  vg_text       (float x, float y, float size, const char *str);
+VGL_API void  vg_textn      (float x, float y, float size, const char *str, const char *end);
+VGL_API void  vg_textf      (float x, float y, float size, const char *format, ...);
+VGL_API float vg_textw      (float size, const char *str, const char *end);
+VGL_API void  vg_close      ();
+
+VGL_API void  vg_fill       (unsigned color);
+VGL_API void  vg_fillr      (unsigned c0, unsigned c1, float x, float y, float r0, float r1);
+VGL_API void  vg_fillb      (unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1);
+VGL_API void  vg_fillg      (unsigned c0, unsigned c1, float x0, float y0, float x1, float y1);
+VGL_API void  vg_fillgr     (unsigned c0, unsigned c1, float x, float y, float w, float h, float r);
+VGL_API void  vg_fillgn     (const unsigned *colors, const float *stops, int n, float x0, float y0, float x1, float y1);
+VGL_API void  vg_fillrn     (const unsigned *colors, const float *stops, int n, float x, float y, float r0, float r1);
+VGL_API void  vg_fillbn     (const unsigned *colors, const float *stops, int n, float x, float y, float w, float h, float r0, float r1);
+VGL_API void  vg_filli      (vgImage *image, const float *matrix);
+VGL_API void  vg_fillbh     (float x, float y, float w, float h, float sat, float val);
+VGL_API void  vg_fillbs     (float x, float y, float w, float h, float hue);
+VGL_API void  vg_shadow     (float x, float y, float w, float h, float radius, float blur, unsigned color);
+VGL_API void  vg_fill_batch (const vgFillItem *items, int n);
+VGL_API void  vg_fill_begin_stream (unsigned c0, unsigned c1, float x0, float y0, float x1, float y1);
+VGL_API void  vg_fill_end_stream   ();
+VGL_API void  vg_stroke     (unsigned color, float width);
+VGL_API void  vg_stroke_dash(unsigned color, float width, const float *pattern, int n, float offset);
+
+VGL_API void  vg_push       ();
+VGL_API void  vg_reset      ();
+VGL_API void  vg_mode       (int mode);
+VGL_API void  vg_winding    (int winding);
+VGL_API void  vg_join       (int join);
+VGL_API void  vg_cap        (int cap);
+VGL_API void  vg_miter      (float limit);
+VGL_API void  vg_spaa       (float spaa);
+VGL_API void  vg_alpha      (float alpha);
+VGL_API void  vg_font       (vgFont *font);
+VGL_API void  vg_matrix     (float *matrix);
+VGL_API void  vg_identity   ();
+VGL_API void  vg_translate  (float x, float y);
+VGL_API void  vg_rotate     (float degs);
+VGL_API void  vg_rotater    (float rads);
+VGL_API void  vg_scale      (float x, float y);
+VGL_API void  vg_project    (float *x, float *y);
+VGL_API void  vg_unproject  (float *x, float *y);
+VGL_API void  vg_projectn   (float *x, float *y);
+VGL_API void  vg_unprojectn (float *x, float *y);
+VGL_API void  vg_clip       (float x, float y, float w, float h);
+VGL_API void  vg_noclip     ();
+VGL_API void  vg_pop();
+
+VGL_API void  vg_size       (int *w, int *h);
+
+// A batch item fills a range of subpaths of the current path, the paint
+// takes the arguments of the matching call in v:
+//   VG_ITEM_FLAT:   vg_fill  (color0)
+//   VG_ITEM_LINEAR: vg_fillg (color0, color1, x0, y0, x1, y1)
+//   VG_ITEM_RADIAL: vg_fillr (color0, color1, x, y, r0, r1)
+//   VG_ITEM_BOX:    vg_fillb (color0, color1, x, y, w, h, r0, r1)
+
+struct vgFillItem {
+	int      first;
+	int      count;
+	int      type;
+	unsigned color0;
+	unsigned color1;
+	float    v[6];
+};
+
+/*//////////////////////////
+// MATH
+//////////////////////////*/
+
+#define VG_PI  (3.14159265358979323846f)
+#define VG_PI2 (VG_PI*2.0f)
+#define VG_SQRT2 (1.41421356237309504880f)
+#define VG_RAD (VG_PI/180.0f)
+#define VG_DEG (180.0f/VG_PI)
+
+/*//////////////////////////
+// POINT
+//////////////////////////*/
+
+struct vgPoint {
+	float x, y;
+};
+
+int vg_point_norm(vgPoint *v, float *l);
+
+/*//////////////////////////
+// MATRIX
+//////////////////////////*/
+
+union vgMatrix {
+	float v[6];
+	float m[3][3];
+	struct {
+		float xx, xy, xt;
+		float yx, yy, yt;
+	};
+};
+
+VGL_API void vg_matrix_identity   (float *m);
+VGL_API void vg_matrix_translate  (float *m, float x, float y);
+VGL_API void vg_matrix_rotate     (float *m, float a);
+VGL_API void vg_matrix_scale      (float *m, float x, float y);
+VGL_API void vg_matrix_multiply   (float *m, float *mul);
+VGL_API int  vg_matrix_inverse    (float *m, float *src);
+VGL_API void vg_matrix_lerp       (float *m, float *mat, float t);
+VGL_API void vg_matrix_project    (float *m, float *x, float *y);
+VGL_API void vg_matrix_unproject  (float *m, float *x, float *y);
+VGL_API void vg_matrix_projectn   (float *m, float *x, float *y);
+VGL_API void vg_matrix_unprojectn (float *m, float *x, float *y);
+VGL_API void vg_matrix_pan        (float *m, float x, float y, float speed);
+VGL_API void vg_matrix_zoom       (float *m, float x, float y, float zoom);
+
+/*//////////////////////////
+// COLOR
+//////////////////////////*/
+
+#define VG_R(c)                   (((c) >>  0) & 0xFF)
+#define VG_G(c)                   (((c) >>  8) & 0xFF)
+#define VG_B(c)                   (((c) >> 16) & 0xFF)
+#define VG_A(c)                   (((c) >> 24) & 0xFF)
+#define VG_RGBA(r, g, b, a)       ((vgColor)((r) | (g) << 8 | (b) << 16 | (a) << 24))
+#define VG_RGB(r, g, b)           VG_RGBA((r), (g), (b), 0xFF)
+#define VG_RGBAF(r, g, b, a)      VG_RGBA((vgColor)(r*0xFF),(vgColor)(g*0xFF),(vgColor)(b*0xFF),(vgColor)(a*0xFF))
+#define VG_RGBF(r, g, b)          VG_RGBA((vgColor)(r*0xFF),(vgColor)(g*0xFF),(vgColor)(b*0xFF),0xFF)
+#define VG_ALPHA(c, a)            ((vgColor)((c & 0x00FFFFFF) | ((VG_A(c) * (a) / 0xFF) << 24)))
+#define VG_ALPHAF(c, a)           VG_ALPHA(c, (vgColor)(a*0xFF))
+#define VG_HSV(h, s, v)           vg_color_hsv((h), (s), (v))
+#define VG_BLEND(src, dst)        vg_color_blend(src, dst)
+#define VG_LERP(src, dst, a)      vg_color_lerp(src, dst, a)
+#define VG_LERPF(src, dst, a)     vg_color_lerpf(src, dst, a)
+
+VGL_API vgColor vg_color_hsv   (float h, float s, float v);
+VGL_API vgColor vg_color_blend (vgColor src, vgColor dst);
+VGL_API vgColor vg_color_lerp  (vgColor src, vgColor dst, vgColor a);
+VGL_API vgColor vg_color_lerpf (vgColor src, vgColor dst, float a);
+
+/*//////////////////////////
+// FONT
+//////////////////////////*/
+
+VGL_API vgFont* vg_font_load         (const char *filename);
+VGL_API vgFont* vg_font_loadp        (void *data, int size);
+VGL_API vgFont* vg_font_default      ();
+VGL_API void    vg_font_draw_char    (vgFont *font, float x, float y, float size, int c);
+VGL_API void    vg_font_draw_text    (vgFont *font, float x, float y, float size, const char *str, const char *end);
+VGL_API float   vg_font_measure_text (vgFont *font, float size, const char *str, const char *end);
+
+/*//////////////////////////
+// SHAPE
+//////////////////////////*/
+
+VGL_API vgShape* vg_shape_create (const vgPoint *points, const int *counts, int ncontours);
+VGL_API void     vg_shape_free   (vgShape *shape);
+VGL_API void     vg_shape_draw   (vgShape *shape);
+
+/*//////////////////////////
+// SCENE
+//////////////////////////*/
+
+VGL_API vgScene* vg_scene_create ();
+VGL_API void     vg_scene_free   (vgScene *scene);
+VGL_API void     vg_scene_fill   (vgScene *scene, vgShape *shape, unsigned color);
+VGL_API void     vg_scene_fillr  (vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x, float y, float r0, float r1);
+VGL_API void     vg_scene_fillb  (vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1);
+VGL_API void     vg_scene_fillg  (vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x0, float y0, float x1, float y1);
+VGL_API void     vg_scene_stroke (vgScene *scene, vgShape *shape, unsigned color, float width);
+VGL_API void     vg_scene_draw   (vgScene *scene);
+
+/*//////////////////////////
+// IMAGE
+//////////////////////////*/
+
+VGL_API vgImage* vg_image_create (const unsigned *pixels, int w, int h);
+VGL_API void     vg_image_free   (vgImage *image);
+
+/*//////////////////////////
+// COMMANDS
+//////////////////////////*/
+
+enum {
+	VG_CMD_END     = 0,
+	VG_CMD_MOVETO  = 1,
+	VG_CMD_LINETO  = 2,
+	VG_CMD_CURVETO = 3,
+	VG_CMD_CUBICTO = 4,
+	VG_CMD_ALPHA   = 5,
+	VG_CMD_FILL    = 6,
+	VG_CMD_STROKE  = 7,
+	// TODO: extend
+};
+
+typedef union vgCommand {
+	unsigned char type;
+	struct { unsigned char type; float coords[2];            } moveto;
+	struct { unsigned char type; float coords[2];            } lineto;
+	struct { unsigned char type; float coords[4];            } curveto;
+	struct { unsigned char type; float coords[6];            } cubicto;
+	struct { unsigned char type; float value;                } alpha;
+	struct { unsigned char type; vgColor color;              } fill;
+	struct { unsigned char type; vgColor color; float width; } stroke;
+} vgCommand;
+
+void vg_eval(vgCommand *commands);
+
+/*//////////////////////////
+// IMPLEMENTATION
+//////////////////////////*/
+
+#if defined(VGL_IMPLEMENTATION) || defined(__INTELLISENSE__)
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+#define VG_MAX_PATH    (2048*2048)
+#define VG_MAX_STATE   (256)
+
+#define VG_TESS_DIST   (4.0f)
+#define VG_TESS_DIST2  (VG_TESS_DIST*VG_TESS_DIST)
+#define VG_TESS_FACTOR (1.0f / VG_TESS_DIST)
+
+typedef union  vgPath    vgPath;
+typedef struct vgState   vgState;
+typedef struct vgContext vgContext;
+
+union vgPath {
+	struct {
+		int closed   : 1;
+		int winding  : 1;
+		int reserved : 30;
+		int end;
+	};
+	vgPoint point;
+};
+
+struct vgState {
+	int      mode;
+	int      winding;
+	int      join;
+	int      cap;
+	float    miter;
+	float    spaa;
+	float    alpha;
+	vgFont*  font;
+	vgMatrix matrix;
+	vgMatrix clip;
+};
+
+#define VG_HISTOGRAM (12) // tiles by edge words: none, then [2^(i-1), 2^i), the last open
+
+struct vgContext {
+	struct {
+		int x;
+		int y;
+	} size;
+	struct {
+		int edges;
+		int tiles;
+		int draws;
+		int upload;
+		int visible;
+		int culled;
+		int headers;
+		int switches;
+		int histogram[VG_HISTOGRAM];
+	} stats;
+	vgState state;
+};
+
+vgContext vg;
+int       vg_initialized;
+int       vg_path_reset;
+int       vg_path_stream;
+int       vg_path_open;
+int       vg_path_index;
+int       vg_path_count;
+vgPoint   vg_path_start;
+vgPoint   vg_path_point;
+vgPath    vg_path_buffer[VG_MAX_PATH];
+vgState   vg_state_buffer[VG_MAX_STATE];
+int       vg_state_count;
+void     *vg_default_font;
+
+static void vg_fill_prime();
+static void vg_fill_stream(float x, float y, int start);
+static void vg_fill_lists();
+static void vg_fill_buckets();
+static void vg_fill_flush();
+
+void vg_driver_init();
+void vg_driver_prime();
+void vg_driver_size(int *w, int *h);
+void vg_driver_clear(unsigned color);
+void vg_driver_flush();
+void vg_driver_ramp(int index, const unsigned *texels);
+void vg_driver_image(int page, int x, int y, int w, int h, const unsigned *pixels);
+void vg_driver_acquire();
+void vg_driver_submit();
+
+void vg_init()
+{
+	if (vg_initialized) return;
+	vg_initialized = 1;
+	memset(&vg, 0, sizeof(vg));
+	vg_driver_init();
+	vg.state.spaa = 0;
+	vg_reset();
+}
+
+void vg_begin()
+{
+	int w, h;
+
+	vg_init();
+
+	vg_driver_size(&w, &h);
+	vg.size.x = w;
+	vg.size.y = h;
+
+	vg.stats.edges  = 0;
+	vg.stats.tiles  = 0;
+	vg.stats.draws  = 0;
+	vg.stats.upload = 0;
+	vg.stats.visible = 0;
+	vg.stats.culled = 0;
+	vg.stats.headers = 0;
+	vg.stats.switches = 0;
+	memset(vg.stats.histogram, 0, sizeof(vg.stats.histogram));
+
+	vg_path_reset  = 1;
+	vg_path_index  = 0;
+	vg_path_count  = 0;
+	vg_state_count = 0;
+
+	vg_reset();
+	vg_fill_prime();
+	vg_driver_prime();
+}
+
+void vg_size(int *w, int *h)
+{
+	*w = vg.size.x;
+	*h = vg.size.y;
+}
+
+void vg_path()
+{
+	if (!vg_path_reset) return;
+	vg_path_reset = 0;
+	vg_path_index = 0;
+	vg_path_count = 0;
+}
+
+static void vg_flush_base()
+{
+	vg_fill_lists();
+	vg_fill_buckets();
+	vg_driver_flush();
+	vg_fill_flush();
+}
+
+// the frame is queued without waiting on the GPU, the next vg_begin
+// blocks only once it runs VGL_RING_SIZE - 1 flushes ahead
+
+void vg_end()
+{
+	vg_flush_base();
+	vg_driver_submit();
+}
+
+void vg_clear(unsigned color)
+{
+	vg_driver_clear(color);
+}
+
+void vg_flush()
+{
+	vg_flush_base();
+	vg_driver_acquire();
+}
+
+static void vg_push_point(float x, float y)
+{
+	assert(vg_path_count < VG_MAX_PATH - 1);
+	vgPoint point = { x, y };
+	vg_path();
+	if (vg_path_stream) {
+		if (!vg_path_open)
+			vg_path_start = point;
+		vg_fill_stream(x, y, !vg_path_open);
+		vg_path_open = 1;
+		vg_path_point = point;
+		return;
+	}
+	if (vg_path_index == vg_path_count) {
+		vgPath *path = &vg_path_buffer[vg_path_count++];
+		path->winding = vg.state.winding >= 0;
+		vg_path_start = point;
+	}
+	vg_path_point = point;
+	vg_path_buffer[vg_path_count++].point = (vgPoint) { x, y };
+}
+
+static void vg_push_path()
+{
+	vg_path_open = 0;
+	if (vg_path_index == vg_path_count) return;
+	vgPath *path = &vg_path_buffer[vg_path_index];
+	path->end = vg_path_count;
+	path->closed = vg_path_point.x == vg_path_start.x && vg_path_point.y == vg_path_start.y;
+	vg_path_index = vg_path_count;
+}
+
+void vg_moveto(float x, float y)
+{
+	vg_push_path();
+	vg_project(&x, &y);
+	vg_push_point(x, y);
+}
+
+void vg_lineto(float x, float y)
+{
+	vg_project(&x, &y);
+	vg_push_point(x, y);
+}
+
+static void vg_curvetor(
+	float x1, float y1,
+	float x2, float y2,
+	float x3, float y3,
+	int level)
+{
+	const float tesstol = 0.125f;
+
+	float x12, y12, x23, y23, x123, y123;
+	float dx, dy, d2;
+
+	if (level > 10) {
+		vg_push_point(x3, y3);
+		return;
+	}
+
+	dx = x3 - x1;
+	dy = y3 - y1;
+	d2 = ((x2 - x3) * dy - (y2 - y3) * dx);
+
+	if ((fabsf(dx) < 0.5f && fabsf(dy) < 0.5f)) {
+		vg_push_point(x3, y3);
+		return;
+	}
+
+	if (d2*d2 < tesstol * (dx*dx + dy*dy)) {
+		vg_push_point(x3, y3);
+		return;
+	}
+
+	x12 = (x1 + x2) * 0.5f;
+	y12 = (y1 + y2) * 0.5f;
+	x23 = (x2 + x3) * 0.5f;
+	y23 = (y2 + y3) * 0.5f;
+	x123 = (x12 + x23) * 0.5f;
+	y123 = (y12 + y23) * 0.5f;
+
+	vg_curvetor(x1, y1, x12, y12, x123, y123, level + 1);
+	vg_curvetor(x123, y123, x23, y23, x3, y3, level + 1);
+}
+
+void vg_curveto(float ax, float ay, float px, float py)
+{
+	float sx, sy;
+
+	if (vg_path_reset) {
+		vg_moveto(px, py);
+		return;
+	}
+
+	vg_project(&ax, &ay);
+	vg_project(&px, &py);
+
+	sx = vg_path_point.x;
+	sy = vg_path_point.y;
+
+	if ((sx < 0 && ax < 0 && px < 0) ||
+		(sx > vg.size.x && ax > vg.size.x && px > vg.size.x) ||
+		(sy < 0 && ax < 0 && px < 0) ||
+		(sy > vg.size.y && ay > vg.size.x && px > vg.size.x)) {
+		vg_push_point(ax, ay);
+		vg_push_point(px, py);
+		return;
+	}
+
+	vg_curvetor(sx, sy, ax, ay, px, py, 0);
+}
+
+static void vg_cubictor(
+	float x1, float y1,
+	float x2, float y2,
+	float x3, float y3,
+	float x4, float y4,
+	int level)
+{
+	// bezier tesselation. thanks to nanovg.
+	const float tesstol = 0.125f;
+
+	float x12, y12, x23, y23, x34, y34, x123, y123, x234, y234, x1234, y1234;
+	float dx, dy, d2, d3;
+
+	if (level > 10) {
+		vg_push_point(x4, y4);
+		return;
+	}
+
+	dx = x4 - x1;
+	dy = y4 - y1;
+	d2 = fabsf(((x2 - x4) * dy - (y2 - y4) * dx));
+	d3 = fabsf(((x3 - x4) * dy - (y3 - y4) * dx));
+
+	if ((fabsf(dx) < 0.5f && fabsf(dy) < 0.5f)) {
+		vg_push_point(x4, y4);
+		return;
+	}
+
+	if ((d2 + d3)*(d2 + d3) < tesstol * (dx*dx + dy*dy)) {
+		vg_push_point(x4, y4);
+		return;
+	}
+
+	x12   = (x1 + x2) * 0.5f;
+	y12   = (y1 + y2) * 0.5f;
+	x23   = (x2 + x3) * 0.5f;
+	y23   = (y2 + y3) * 0.5f;
+	x34   = (x3 + x4) * 0.5f;
+	y34   = (y3 + y4) * 0.5f;
+	x123  = (x12 + x23) * 0.5f;
+	y123  = (y12 + y23) * 0.5f;
+	x234  = (x23 + x34) * 0.5f;
+	y234  = (y23 + y34) * 0.5f;
+	x1234 = (x123 + x234) * 0.5f;
+	y1234 = (y123 + y234) * 0.5f;
+
+	vg_cubictor(x1, y1, x12, y12, x123, y123, x1234, y1234, level + 1);
+	vg_cubictor(x1234, y1234, x234, y234, x34, y34, x4, y4, level + 1);
+}
+
+void vg_cubicto(float ax, float ay, float bx, float by, float px, float py)
+{
+	float sx, sy;
+
+	if (vg_path_reset) {
+		vg_moveto(px, py);
+		return;
+	}
+
+	vg_project(&ax, &ay);
+	vg_project(&bx, &by);
+	vg_project(&px, &py);
+
+	sx = vg_path_point.x;
+	sy = vg_path_point.y;
+
+	if ((sx < 0 && ax < 0 && bx < 0 && px < 0) ||
+		(sx > vg.size.x && ax > vg.size.x && bx > vg.size.x && px > vg.size.x) ||
+		(sy < 0 && ay < 0 && by < 0 && py < 0) ||
+		(sy > vg.size.y && ay > vg.size.y && by > vg.size.y && py > vg.size.y)) {
+		vg_push_point(ax, ay);
+		vg_push_point(bx, by);
+		vg_push_point(px, py);
+		return;
+	}
+
+	vg_cubictor(sx, sy, ax, ay, bx, by, px, py, 0);
+}
+
+void vg_close()
+{
+	if (vg_path_point.x != vg_path_start.x ||
+		vg_path_point.y != vg_path_start.y) {
+		vg_push_point(vg_path_start.x, vg_path_start.y);
+	}
+}
+
+void vg_line(float x0, float y0, float x1, float y1)
+{
+	vg_moveto(x0, y0);
+	vg_lineto(x1, y1);
+}
+
+void vg_vline(float x, float y0, float y1)
+{
+	vg_moveto(x, y0);
+	vg_lineto(x, y1);
+}
+
+void vg_hline(float y, float x0, float x1)
+{
+	vg_moveto(x0, y);
+	vg_lineto(x1, y);
+}
+
+void vg_arc(float x, float y, float a0, float a1, float r)
+{
+	static int   cached;
+	static float points[2048][2];
+	const  int   cachesize = sizeof(points) / sizeof(points[0]);
+
+	if (!cached) {
+		float step = 3.14159265359f * 2.0f / cachesize;
+		float angle = 0.0f;
+		for (int index = 0; index < cachesize; index++) {
+			angle += step;
+			points[index][0] = cosf(angle);
+			points[index][1] = sinf(angle);
+		}
+		cached = 1;
+	}
+
+	float delta, start, angle, step, *vector, sx, sy;
+	int index, id, count, closed;
+
+	sx = vg.state.matrix.xx + vg.state.matrix.xy;
+	sy = vg.state.matrix.yx + vg.state.matrix.yy;
+
+	count = 4 + (int)(fabsf(r) * 0.75f * sqrtf(sx * sx + sy * sy));
+	if (count > 256) count = 256;
+
+	delta = a1 - a0;
+	delta = delta < -360.0f ? -360.0f : delta > 360.0f ? 360.0f : delta;
+	closed = delta == 360.0f;
+	step = 1.0f / (count - 1) * delta / 360.0f;
+	start = angle = a0 / 360.0f;
+	if (r < 0) step = -step;
+
+	for (index = 0; index < count; index++) {
+		id = ((int)(angle * cachesize) % cachesize + cachesize) % cachesize;
+		vector = points[id];
+		if (index == 0) {
+			vg_moveto(x + vector[0] * r, y + vector[1] * r);
+		} else {
+			vg_lineto(x + vector[0] * r, y + vector[1] * r);
+		}
+		if (closed && index == count - 2) {
+			angle = start;
+		} else {
+			angle += step;
+		}
+	}
+}
+
+void vg_ellipse(float x, float y, float rx, float ry)
+{
+	vgMatrix m;
+	m = vg.state.matrix;
+	vg_scale(rx, ry);
+	vg_arc(x, y, 0, 360, 1.0f);
+	vg.state.matrix = m;
+}
+
+void vg_circle(float x, float y, float r)
+{
+	vg_arc(x, y, 0, 360, r);
+}
+
+void vg_rect(float x, float y, float w, float h)
+{
+	vg_moveto(x, y);
+	vg_lineto(x + w, y);
+	vg_lineto(x + w, y + h);
+	vg_lineto(x, y + h);
+	vg_lineto(x, y);
+}
+
+void vg_rectr(float x, float y, float w, float h, float rx, float ry)
+{
+	float hw, hh;
+
+	hw = w * 0.5f;
+	hh = h * 0.5f;
+	rx = (rx > fabsf(hw)) ? hw : hw > 0 ? rx : -rx;
+	ry = (ry > fabsf(hh)) ? hh : hh > 0 ? ry : -ry;
+
+	vg_moveto  (x + rx,     y                                  );
+	vg_lineto  (x + w - rx, y                                  );
+	vg_curveto (x + w,      y,          x + w,      y + ry     );
+	vg_lineto  (x + w,      y + h - ry                         );
+	vg_curveto (x + w,      y + h,      x + w - rx, y + h      );
+	vg_lineto  (x + rx,     y + h                              );
+	vg_curveto (x,          y + h,      x,          y + h - ry );
+	vg_lineto  (x,          y + ry                             );
+	vg_curveto (x,          y,          x + rx,     y          );
+}
+
+static void vg_polyline_column(int ei, int ni, int mi, int li, float nx, float ny, float mx, float my, float lx, float ly)
+{
+	if (ni > mi) {
+		if (mi != ei) vg_push_point(mx, my);
+		if (ni != li) vg_push_point(nx, ny);
+	} else if (ni < mi) {
+		if (ni != ei) vg_push_point(nx, ny);
+		if (mi != li) vg_push_point(mx, my);
+	}
+	if (li != ei) vg_push_point(lx, ly);
+}
+
+void vg_polyline_decimated(const float *xs, const float *ys, int n)
+{
+	// collapses every device pixel column to its entry, min, max and exit samples.
+	// the reduced path covers the same pixels, so cost follows width instead of n.
+	float xx, xy, xt, yx, yy, yt;
+	float x, y, nx, ny, mx, my, lx, ly;
+	int i, ei, ni, mi, li, col;
+
+	if (n <= 0) return;
+
+	xx = vg.state.matrix.xx; xy = vg.state.matrix.xy; xt = vg.state.matrix.xt;
+	yx = vg.state.matrix.yx; yy = vg.state.matrix.yy; yt = vg.state.matrix.yt;
+
+	x = xs[0] * xx + ys[0] * xy + xt;
+	y = xs[0] * yx + ys[0] * yy + yt;
+
+	vg_push_path();
+	vg_push_point(x, y);
+
+	col = (int)floorf(x);
+	ei = ni = mi = li = 0;
+	nx = mx = lx = x;
+	ny = my = ly = y;
+
+	for (i = 1; i < n; i++) {
+		x = xs[i] * xx + ys[i] * xy + xt;
+		y = xs[i] * yx + ys[i] * yy + yt;
+
+		if ((int)floorf(x) == col) {
+			if (y < ny) { nx = x; ny = y; ni = i; }
+			if (y > my) { mx = x; my = y; mi = i; }
+			lx = x; ly = y; li = i;
+			continue;
+		}
+
+		vg_polyline_column(ei, ni, mi, li, nx, ny, mx, my, lx, ly);
+		vg_push_point(x, y);
+
+		col = (int)floorf(x);
+		ei = ni = mi = li = i;
+		nx = mx = lx = x;
+		ny = my = ly = y;
+	}
+
+	vg_polyline_column(ei, ni, mi, li, nx, ny, mx, my, lx, ly);
+}
+
+void vg_char(float x, float y, float size, int c)
+{
+	if (!vg.state.font) return;
+	vg_font_draw_char(vg.state.font, x, y, size, c);
+}
+
+void vg_text(float x, float y, float size, const char *str)
+{
+	if (!vg.state.font) return;
+	vg_font_draw_text(vg.state.font, x, y, size, str, 0);
+}
+
+void vg_textn(float x, float y, float size, const char *str, const char *end)
+{
+	if (!vg.state.font) return;
+	vg_font_draw_text(vg.state.font, x, y, size, str, end);
+}
+
+void vg_textf(float x, float y, float size, const char *format, ...)
+{
+	va_list args; int length; char sbuff[512], *pbuff, *mbuff = 0;
+	va_start(args, format);
+	length = vsnprintf(0, 0, format, args);
+	va_end(args);
+	if (length < sizeof(sbuff)) pbuff = sbuff;
+	else pbuff = mbuff = malloc(length + 1);
+	va_start(args, format);
+	vsnprintf(pbuff, length + 1, format, args);
+	va_end(args);
+	vg_font_draw_text(vg.state.font, x, y, size, pbuff, pbuff + length);
+	if (mbuff) free(mbuff);
+}
+
+float vg_textw(float size, const char *str, const char *end)
+{
+	if (!vg.state.font) return 0;
+	return vg_font_measure_text(vg.state.font, size, str, end);
+}
+
+void vg_reset()
+{
+	vg.state.mode = VG_NONZERO;
+	vg.state.winding = VG_POSITIVE;
+	vg.state.join = VG_JOIN_MITER;
+	vg.state.cap = VG_CAP_BUTT;
+	vg.state.miter = 4.0f;
+	vg.state.alpha = 1.0f;
+	vg_identity();
+	vg_noclip();
+}
+
+void vg_push()
+{
+	vg_state_buffer[vg_state_count++] = vg.state;
+}
+
+void vg_pop()
+{
+	vg.state = vg_state_buffer[--vg_state_count];
+}
+
+void vg_mode(int mode)
+{
+	vg.state.mode = mode;
+}
+
+void vg_winding(int winding)
+{
+	vg.state.winding = winding;
+}
+
+void vg_join(int join)
+{
+	vg.state.join = join;
+}
+
+void vg_cap(int cap)
+{
+	vg.state.cap = cap;
+}
+
+void vg_miter(float limit)
+{
+	vg.state.miter = limit;
+}
+
+void vg_spaa(float spaa)
+{
+	vg.state.spaa = spaa;
+}
+
+void vg_alpha(float alpha)
+{
+	if (alpha < 0) alpha = 0;
+	else if (alpha > 1) alpha = 1;
+	vg.state.alpha *= alpha;
+}
+
+void vg_font(vgFont *font)
+{
+	vg.state.font = font;
+}
+
+void vg_matrix(float *matrix)
+{
+	vg.state.matrix = *(vgMatrix*)matrix;
+}
+
+void vg_identity()
+{
+	vg_matrix_identity(vg.state.matrix.v);
+}
+
+void vg_translate(float x, float y)
+{
+	vg_matrix_translate(vg.state.matrix.v, x, y);
+}
+
+void vg_rotate(float degs)
+{
+	vg_matrix_rotate(vg.state.matrix.v, degs * (VG_PI / 180.0f));
+}
+
+void vg_rotater(float rads)
+{
+	vg_matrix_rotate(vg.state.matrix.v, rads);
+}
+
+void vg_scale(float x, float y)
+{
+	vg_matrix_scale(vg.state.matrix.v, x, y);
+}
+
+void vg_project(float *x, float *y)
+{
+	vg_matrix_project(vg.state.matrix.v, x, y);
+}
+
+void vg_unproject(float *x, float *y)
+{
+	vg_matrix_unproject(vg.state.matrix.v, x, y);
+}
+
+void vg_projectn(float *x, float *y)
+{
+	vg_matrix_projectn(vg.state.matrix.v, x, y);
+}
+
+void vg_unprojectn(float *x, float *y)
+{
+	vg_matrix_unprojectn(vg.state.matrix.v, x, y);
+}
+
+void vg_clip(float x, float y, float w, float h)
+{
+	x += 0.5f; y += 0.5f; w -= 1.0f; h -= 1.0f;
+	float iw = 1.0f / w, ih = 1.0f / h;
+	vg_matrix_inverse(vg.state.clip.v, vg.state.matrix.v);
+	vg.state.clip.v[0] = vg.state.clip.v[0] * iw;
+	vg.state.clip.v[1] = vg.state.clip.v[1] * iw;
+	vg.state.clip.v[2] = vg.state.clip.v[2] * iw - x * iw;
+	vg.state.clip.v[3] = vg.state.clip.v[3] * ih;
+	vg.state.clip.v[4] = vg.state.clip.v[4] * ih;
+	vg.state.clip.v[5] = vg.state.clip.v[5] * ih - y * ih;
+}
+
+void vg_noclip()
+{
+	vg.state.clip.v[0] = 0.0f;
+	vg.state.clip.v[1] = 0.0f;
+	vg.state.clip.v[2] = 0.5f;
+	vg.state.clip.v[3] = 0.0f;
+	vg.state.clip.v[4] = 0.0f;
+	vg.state.clip.v[5] = 0.5f;
+}
+
+/*//////////////////////////
+// POINT
+//////////////////////////*/
+
+int vg_point_norm(vgPoint *v, float *l)
+{
+	float d, i;
+	d = v->x*v->x + v->y*v->y;
+	if (d > 0) {
+		i = 1.0f / sqrtf(d);
+		v->x *= i;
+		v->y *= i;
+		*l = d;
+		return 1;
+	} else {
+		v->x = 0;
+		v->y = 0;
+		*l = 0;
+		return 0;
+	}
+}
+
+/*//////////////////////////
+// RECT
+//////////////////////////*/
+
+typedef struct vgRect {
+	int minx, miny;
+	int maxx, maxy;
+} vgRect;
+
+static vgRect vg_rect_add(vgRect a, int x, int y)
+{
+	vgRect r;
+	r.minx = a.minx < x ? a.minx : x;
+	r.miny = a.miny < y ? a.miny : y;
+	r.maxx = a.maxx > x ? a.maxx : x;
+	r.maxy = a.maxy > y ? a.maxy : y;
+	return r;
+}
+
+static vgRect vg_rect_inflate(vgRect a, int rx, int ry)
+{
+	vgRect r;
+	r.minx = a.minx - rx;
+	r.miny = a.miny - ry;
+	r.maxx = a.maxx + rx;
+	r.maxy = a.maxy + ry;
+	return r;
+}
+
+static vgRect vg_rect_clamp(vgRect a, vgRect b)
+{
+	vgRect r;
+	r.minx = a.minx > b.minx ? a.minx : b.minx;
+	r.miny = a.miny > b.miny ? a.miny : b.miny;
+	r.maxx = a.maxx < b.maxx ? a.maxx : b.maxx;
+	r.maxy = a.maxy < b.maxy ? a.maxy : b.maxy;
+	return r;
+}
+
+static vgRect vg_rect_union(vgRect a, vgRect b)
+{
+	vgRect c;
+	c.minx = a.minx < b.minx ? a.minx : b.minx;
+	c.miny = a.miny < b.miny ? a.miny : b.miny;
+	c.maxx = a.maxx > b.maxx ? a.maxx : b.maxx;
+	c.maxy = a.maxy > b.maxy ? a.maxy : b.maxy;
+	return c;
+}
+
+/*//////////////////////////
+// FILL
+//////////////////////////*/
+
+// VGL works by cutting paths into tiles and evaluating trapezoidal coverage on the GPU.
+// Edges use 8bit fixed-point coordinates(x0, y0, x1, y1), totaling 32bits per edge and are uploaded to a texture as strips of shared end points.
+// Tiles are 8 byte instances drawn as 4-vertex triangle strips, each holding its position, the sign (inside / outside) state of it's bottom-left corner, its edge count and offset, and an entry in a per-flush side table pointing at the fill header and the base of its edges.
+// A sign buffer is used to track when paths cross the top/bottom of tiles.
+// Before filling, the sign buffer is scanned from left to right, accumilating sign per tile.
+
+#define VG_GRID_SIZE   (1024)
+
+#ifndef VG_MAX_DATA
+#define VG_MAX_DATA    (2048*2048) // words per flush, may exceed 16M
+#endif
+#ifndef VG_MAX_ENTRIES
+#define VG_MAX_ENTRIES (16384)     // side table entries per flush, at most 1 << 14
+#endif
+#ifndef VG_MAX_TILES
+#define VG_MAX_TILES   (2048*128)
+#endif
+#define VG_MAX_EDGES   (1 << 18)
+#ifndef VG_BATCH_ITEMS
+#define VG_BATCH_ITEMS (1024)      // batch items binned ahead of their tiles
+#endif
+
+#define VG_PIXEL_LOG2  (4) // subpixel precision (16x16 for 256AA)
+#define VG_PIXEL_SIZE  (1 << VG_PIXEL_LOG2)
+#define VG_PIXEL_MASK  (VG_PIXEL_SIZE - 1)
+
+#define VG_TILE_LOG2   (7) // tile precision (128/16 for 8px per tile)
+#define VG_TILE_SIZE   (1 << VG_TILE_LOG2)
+#define VG_TILE_DIMS   (VG_TILE_SIZE / VG_PIXEL_SIZE)
+#define VG_TILE_MASK   (VG_TILE_SIZE - 1)
+
+#define VG_EDGE_LOG2   (8) // edge precision
+#define VG_EDGE_SIZE   (1 << VG_EDGE_LOG2)
+#define VG_EDGE_MASK   (VG_EDGE_SIZE - 1)
+#define VG_EDGE_BORDER ((VG_EDGE_SIZE - VG_TILE_SIZE) / 2)
+
+#define VG_LIST_WORDS  (2) // tile list entry: coord, edges
+
+#define VG_COMPUTE_DIMS  8      // workgroup size, a bare literal for the layout qualifier
+#define VG_COMPUTE_EDGES (1024) // words of edge strips staged in shared memory
+
+#if VG_COMPUTE_DIMS != VG_TILE_DIMS
+#error "VG_COMPUTE_DIMS must match VG_TILE_DIMS"
+#endif
+
+#define VG_BIN_GROUP    256       // workgroup size, a bare literal for the layout qualifier
+#define VG_BIN_WORDS    (8)       // bin record: header, points, first point, cell, row, origin, size, count
+#define VG_BIN_DEPTH    (16)      // halvings of long segments
+#define VG_MAX_BINS     (VG_ENTRY_WORDS / VG_BIN_WORDS)
+#define VG_MAX_CELLS    (1 << 20)
+#define VG_MAX_ROWS     (1 << 16)
+
+#define VG_BIN_START    (1) // point flags
+#define VG_BIN_NEGATIVE (2)
+
+#define VG_BIN_COUNT    (0) // compute passes
+#define VG_BIN_ROWS     (1)
+#define VG_BIN_SCAN     (2)
+#define VG_BIN_EMIT     (3)
+#define VG_BIN_EDGES    (4)
+
+#define VG_VARIANT_COUNT (4) // flat or gradient, with or without subpixel AA
+#define VG_MAX_RUNS      (4096)
+
+#define VG_FILL_FLAT    (0)
+#define VG_FILL_LIN     (1)
+#define VG_FILL_RAD     (2)
+#define VG_FILL_RAD_HUE (3)
+#define VG_FILL_RAD_SAT (4)
+#define VG_FILL_BOX     (5)
+#define VG_FILL_BOX_HUE (6)
+#define VG_FILL_BOX_SAT (7)
+#define VG_FILL_GRID    (8)
+#define VG_FILL_IMAGE   (9)
+#define VG_FILL_SHADOW  (10)
+
+// Multi-stop gradients sample a row of the ramp atlas, args.rsv1 holds the row
+// plus one. Rows are kept across frames, keyed by a hash of their stops.
+// Image fills keep their page of the image atlas in args.rsv1, the origin of
+// their block in extent and their size in radius.
+// Shadow fills cover whole tiles without edges, extent holds the half size of
+// the box and radius its corner radius and the deviation of the blur.
+
+#define VG_RAMP_SIZE    (256) // texels per ramp
+#define VG_MAX_RAMPS    (255) // rows of the atlas
+
+// Hairline fills hold line segments in place of edges, coverage is taken from
+// the distance to the nearest segment. The width is stored in args.rsv1 in
+// 1/64 pixels. They need strip edges binned on the CPU.
+
+#define VG_HAIRLINE     (5)
+#define VG_HAIRLINES    (VGL_HAIRLINE_WIDTH > 0 && !VGL_EDGE_SLOPES && !VGL_GPU_BINNING)
+
+// Dash fills hold line segments the same way, each followed by a word with the
+// arc length at its first point wrapped to the pattern period. Their pattern
+// block holds the ends of up to three dash and gap pairs, padded with the
+// period, args.rsv1 holds the cap and the number of pairs shifted by 2.
+
+#define VG_DASH         (6)
+#define VG_DASH_MAX     (6) // pattern entries held by a dash fill
+#define VG_LINE_REACH   ((float)VG_EDGE_BORDER / VG_PIXEL_SIZE) // pixels a line may reach past its tile
+
+// Fill headers are uploaded in a compact form keyed by type:
+//   flat:     args, color0, clip
+//   gradient: args, color0, clip, color1, matrix, extent[2], radius[2]
+//   dash:     args, color0, clip, pattern, width
+// clip and matrix refer to 6-word blocks shared through a per-flush table,
+// VG_BLOCK_NONE marks the default clip. A fill equal to the previous one
+// reuses its header.
+
+#define VG_HEADER_FLAT (3)
+#define VG_HEADER_GRAD (9)
+#define VG_HEADER_DASH (5)
+#define VG_HEADER_WORDS(f) ((f)->type != VG_FILL_FLAT ? VG_HEADER_GRAD : (f)->mode == VG_DASH ? VG_HEADER_DASH : VG_HEADER_FLAT)
+#define VG_BLOCK_SIZE  (6)
+#define VG_BLOCK_SLOTS (1024)
+#define VG_BLOCK_PROBE (8)
+#define VG_BLOCK_NONE  (0xFFFFFFFF)
+
+#define VG_TILE_ESCAPE (255)
+#define VG_TILE_OFFSET (1024)
+#define VG_TILE_BANDED (0x8000) // escape count flag
+#define VG_TILE_BANDS  (4)
+
+#ifndef VG_TILE_HEAVY
+#define VG_TILE_HEAVY  (16) // edge words from which a tile is split into bands
+#endif
+#define VG_ENTRY_WORDS (VG_MAX_ENTRIES * 2)
+#define VG_ENTRY_SIZE  (VGL_GPU_BINNING ? VG_BIN_WORDS : 2)
+
+#pragma pack(push, 1)
+
+typedef struct vgFill {
+	union {
+		struct {
+			char mode;
+			char type;
+			char spaa;
+			char rsv1;
+		};
+		unsigned args;
+	};
+	unsigned color0;
+	unsigned color1;
+	unsigned clip[6];
+	unsigned matrix[6];
+	unsigned extent[2];
+	unsigned radius[2];
+} vgFill;
+
+// Tiles are 8 byte instances:
+//   coord: x[0:12] y[12:24] sign[24:32]
+//   edges: count[0:8] offset[8:18] entry[18:32]
+// entry selects a per-flush side table at the start of the data segment,
+// two words per entry: the fill header and the base of its edge block.
+// offset is relative to that base, a fill spanning more opens new entries.
+// A tile whose sign or count does not fit stores count VG_TILE_ESCAPE and
+// offsets to a word after its edges holding sign[0:16] and count[16:32].
+// Heavy tiles escape with VG_TILE_BANDED set in the count, their edges are
+// led by the 16 bit starts of VG_TILE_BANDS row bands, each holding only the
+// edges overlapping its rows.
+
+typedef struct vgTile {
+	unsigned coord;
+	unsigned edges;
+} vgTile;
+
+typedef union vgEdge {
+	struct {
+		unsigned char x0;
+		unsigned char y0;
+		unsigned char x1;
+		unsigned char y1;
+	};
+	unsigned packed;
+} vgEdge;
+
+#pragma pack(pop)
+
+// Each flush is drawn as a list of instance ranges, one program per range
+typedef struct vgDraw {
+	int variant;
+	int first;
+	int count;
+} vgDraw;
+
+// the driver points these at the memory the next flush uploads from,
+// either the storage below or a persistently mapped GPU ring segment
+unsigned    vg_data_storage[VG_MAX_DATA];
+unsigned   *vg_data_buffer = vg_data_storage;
+int         vg_data_base;
+int         vg_data_count;
+
+int         vg_entry_count;
+int         vg_entry_data;
+int         vg_entry_edges;
+
+int         vg_block_index[VG_BLOCK_SLOTS];
+unsigned    vg_block_words[VG_BLOCK_SLOTS][VG_BLOCK_SIZE];
+unsigned    vg_header_words[VG_HEADER_GRAD];
+int         vg_header_size;
+int         vg_header_index;
+
+vgTile      vg_tile_storage[VG_MAX_TILES];
+vgTile     *vg_tile_buffer = vg_tile_storage;
+int         vg_tile_count;
+
+vgDraw      vg_draw_buffer[VG_MAX_RUNS * VG_VARIANT_COUNT];
+int         vg_draw_count;
+int         vg_draw_variant;
+
+int         vg_run_start[VG_MAX_RUNS + 1];
+int         vg_run_count;
+int         vg_run_stamp;
+#if VGL_VARIANTS
+vgTile      vg_tile_stage[VG_MAX_TILES];
+char        vg_tile_variant[VG_MAX_TILES];
+int         vg_tile_mark[VG_GRID_SIZE * VG_GRID_SIZE];
+#endif
+
+vgEdge      vg_edge_buffer[VG_MAX_EDGES];
+int         vg_edge_links[VG_MAX_EDGES];
+float       vg_edge_arcs[VG_MAX_EDGES]; // dash fills only
+int         vg_edge_count;
+
+vgEdge      vg_strip_edges[VG_MAX_EDGES];
+vgEdge      vg_band_edges[VG_MAX_EDGES];
+unsigned short vg_strip_points[VG_MAX_EDGES * 3 + 1];
+
+signed char vg_tile_sign[VG_GRID_SIZE * VG_GRID_SIZE];
+int         vg_tile_edge[VG_GRID_SIZE * VG_GRID_SIZE];
+#if VGL_TILE_LISTS
+int         vg_tile_list[VG_GRID_SIZE * VG_GRID_SIZE];
+#endif
+
+// Batch fills keep the cells each item touched while binned, taking their edge
+// list and sign once it ends. The count runs past VG_MAX_EDGES on overflow.
+typedef struct vgBatchCell {
+	int index;
+	int edge;
+	int sign;
+} vgBatchCell;
+
+typedef struct vgBatchItem {
+	int    item;
+	vgRect bounds;
+	int    first; // cells
+	int    count;
+	int    edges;
+} vgBatchItem;
+
+vgBatchCell vg_batch_cells[VG_MAX_EDGES];
+int         vg_batch_count;
+vgBatchItem vg_batch_items[VG_BATCH_ITEMS];
+int         vg_batch_pending;
+int         vg_batch_active;
+
+// GPU binning: a fill records its flattened contours as points (x, y, flags), they
+// are uploaded with the header and a bin record in place of the entry table. The
+// compute passes count edges and signs per cell of the fill's bounds, scan rows
+// into tiles, write the edges after the data and draw the tiles indirectly.
+#if VGL_GPU_BINNING
+unsigned    vg_bin_points[VG_MAX_EDGES * 3];
+int         vg_bin_count;   // points of the current fill
+int         vg_bin_edges;   // bound on edges of the current fill
+int         vg_bin_total;   // points of the flush
+int         vg_bin_cells;
+int         vg_bin_rows;
+int         vg_bin_reserve; // words the passes may write after the data
+#endif
+
+float       vg_grid_scalex;
+float       vg_grid_scaley;
+int         vg_grid_sizex;
+int         vg_grid_sizey;
+vgRect      vg_grid_bounds;
+
+int         vg_fill_reset;
+int         vg_fill_lines;  // VG_HAIRLINE or VG_DASH while lines are binned
+float       vg_dash_period;
+vgPoint     vg_fill_start;
+vgPoint     vg_fill_point;
+int         vg_fill_winding;
+int         vg_fill_variant;
+int         vg_flush_stamp;
+
+static void vg_push_fill(vgFill *fill, int ntiles, int nedges);
+static void vg_push_tile(int x, int y, int sign, void* edges, int count);
+static void vg_fill_lineto(float x, float y);
+
+static void vg_fill_prime()
+{
+	vg_data_count  = VG_ENTRY_WORDS;
+	vg_entry_count = 0;
+	vg_tile_count  = 0;
+	vg_header_size = 0;
+	memset(vg_block_index, 0, sizeof(vg_block_index));
+	vg_grid_scalex = vg.size.x / (float)VG_TILE_DIMS;
+	vg_grid_scaley = vg.size.y / (float)VG_TILE_DIMS;
+	vg_grid_sizex  = (int)ceilf(vg_grid_scalex) + 2;
+	vg_grid_sizey  = (int)ceilf(vg_grid_scaley) + 2;
+	memset(vg_tile_sign, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_sign[0]));
+	memset(vg_tile_edge, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_edge[0]));
+	vg_draw_variant = -1;
+#if VGL_VARIANTS
+	memset(vg_tile_mark, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_mark[0]));
+	vg_run_count = 1;
+	vg_run_stamp = 1;
+#endif
+#if VGL_GPU_BINNING
+	vg_bin_total   = 0;
+	vg_bin_cells   = 0;
+	vg_bin_rows    = 0;
+	vg_bin_reserve = 0;
+#endif
+}
+
+static void vg_fill_lists()
+{
+#if VGL_TILE_LISTS
+	vgTile *tile; unsigned *entry;
+	int i, index, count, start, end;
+
+	// count the fills touching every screen tile, read back from system memory
+	// as the ring may be mapped write only
+	for (i = 0; i < vg_tile_count; i++) {
+		tile = &vg_tile_storage[i];
+		index = (tile->coord & 0xFFF) + ((tile->coord >> 12) & 0xFFF) * vg_grid_sizex;
+		vg_tile_list[index] += VG_LIST_WORDS;
+	}
+
+	// allocate the lists in grid order after the fill data, each led by its length
+	start = vg_data_count + vg_data_base;
+	for (index = 0; index < vg_grid_sizex * vg_grid_sizey; index++) {
+		if (vg_tile_list[index] == 0) continue;
+		count = vg_tile_list[index];
+		vg_data_buffer[start - vg_data_base] = count / VG_LIST_WORDS;
+		vg_tile_list[index] = start + 1;
+		start += count + 1;
+	}
+
+	// scatter in paint order
+	for (i = 0; i < vg_tile_count; i++) {
+		tile = &vg_tile_storage[i];
+		index = (tile->coord & 0xFFF) + ((tile->coord >> 12) & 0xFFF) * vg_grid_sizex;
+		entry = &vg_data_buffer[vg_tile_list[index] - vg_data_base];
+		entry[0] = tile->coord;
+		entry[1] = tile->edges;
+		vg_tile_list[index] += VG_LIST_WORDS;
+	}
+
+	// replace the instances with one per screen tile pointing at its list
+	start = vg_data_count + vg_data_base;
+	count = 0;
+	for (index = 0; index < vg_grid_sizex * vg_grid_sizey; index++) {
+		if (vg_tile_list[index] == 0) continue;
+		end = vg_tile_list[index];
+		tile = &vg_tile_buffer[count++];
+		tile->coord = (index % vg_grid_sizex) | ((index / vg_grid_sizex) << 12);
+		tile->edges = start;
+		vg_tile_list[index] = 0;
+		start = end;
+	}
+
+	vg_data_count = start - vg_data_base;
+	vg_tile_count = count;
+#endif
+}
+
+// Variants: tiles are staged with the variant of their fill and bucketed at flush.
+// A run ends when a tile lands on a screen tile already covered in the run by a
+// higher variant, so drawing each run's buckets in variant order keeps paint order.
+
+static void vg_fill_buckets()
+{
+	vgDraw *draw;
+#if VGL_VARIANTS
+	int first[VG_VARIANT_COUNT];
+	int run, index, start, end, variant, count;
+
+	vg_draw_count = 0;
+	vg_run_start[vg_run_count] = vg_tile_count;
+	count = 0;
+
+	for (run = 0; run < vg_run_count; run++) {
+		start = vg_run_start[run];
+		end = vg_run_start[run + 1];
+
+		memset(first, 0, sizeof(first));
+		for (index = start; index < end; index++)
+			first[(int)vg_tile_variant[index]]++;
+
+		for (variant = 0; variant < VG_VARIANT_COUNT; variant++) {
+			if (first[variant] == 0) continue;
+			if (vg_draw_count > 0 && vg_draw_buffer[vg_draw_count - 1].variant == variant) {
+				vg_draw_buffer[vg_draw_count - 1].count += first[variant];
+			} else {
+				draw = &vg_draw_buffer[vg_draw_count++];
+				draw->variant = variant;
+				draw->first = count;
+				draw->count = first[variant];
+			}
+			start = first[variant];
+			first[variant] = count;
+			count += start;
+		}
+
+		for (index = vg_run_start[run]; index < end; index++)
+			vg_tile_buffer[first[(int)vg_tile_variant[index]]++] = vg_tile_stage[index];
+	}
+#else
+	draw = &vg_draw_buffer[0];
+	draw->variant = 0;
+	draw->first = 0;
+	draw->count = vg_tile_count;
+	vg_draw_count = vg_tile_count > 0;
+#endif
+
+	for (draw = vg_draw_buffer; draw < vg_draw_buffer + vg_draw_count; draw++) {
+		if (draw->variant != vg_draw_variant)
+			vg.stats.switches++;
+		vg_draw_variant = draw->variant;
+	}
+}
+
+static void vg_fill_flush()
+{
+	// binned tiles and edges are produced on the GPU, the tile count is a bound
+	vg.stats.draws += vg_draw_count;
+	vg.stats.tiles += VGL_GPU_BINNING ? 0 : vg_tile_count;
+	vg.stats.upload += VGL_GPU_BINNING ? 0 : sizeof(vgTile) * vg_tile_count;
+	vg.stats.upload += sizeof(unsigned) * (vg_data_count - VG_ENTRY_WORDS + vg_entry_count * VG_ENTRY_SIZE);
+
+	vg_tile_count  = 0;
+	vg_entry_count = 0;
+	vg_data_count  = VG_ENTRY_WORDS;
+	vg_header_size = 0;
+	memset(vg_block_index, 0, sizeof(vg_block_index));
+	vg_draw_count  = 0;
+	vg_flush_stamp++;
+#if VGL_VARIANTS
+	vg_run_count = 1;
+	vg_run_stamp++;
+#endif
+#if VGL_GPU_BINNING
+	vg_bin_total   = 0;
+	vg_bin_cells   = 0;
+	vg_bin_rows    = 0;
+	vg_bin_reserve = 0;
+#endif
+}
+
+static void vg_fill_empty()
+{
+	vg_edge_count = 1;
+#if VGL_GPU_BINNING
+	vg_bin_count = 0;
+	vg_bin_edges = 0;
+#endif
+	vg_grid_bounds.minx = vg_grid_sizex;
+	vg_grid_bounds.miny = vg_grid_sizey;
+	vg_grid_bounds.maxx = 0;
+	vg_grid_bounds.maxy = 0;
+}
+
+static void vg_fill_begin()
+{
+	// a fill or stroke while streaming would drop the edges binned so far
+	assert(!vg_path_stream);
+	vg_push_path();
+	vg_path_reset = 1;
+	vg_fill_reset = 1;
+	vg_fill_winding = vg.state.winding;
+	vg_fill_empty();
+}
+
+static void vg_fill_set(vgFill *fill, int mode, int type, unsigned c0, unsigned c1, float e0, float e1, float r0, float r1, vgMatrix *m)
+{
+	vgMatrix minv, mclip;
+	int spaa, alpha;
+	spaa = (int)(vg.state.spaa * 255);
+	spaa = spaa < 0 ? 0 : spaa > 255 ? 255 : spaa;
+	alpha = (int)(vg.state.alpha * 255);
+	alpha = alpha < 0 ? 0 : alpha > 255 ? 255 : alpha;
+	mclip = vg.state.clip;
+	vg_matrix_inverse(minv.v, m->v);
+	fill->mode = mode;
+	fill->type = type;
+	fill->spaa = spaa;
+	fill->rsv1 = 0;
+	fill->color0 = VG_ALPHA(c0, alpha);
+	fill->color1 = VG_ALPHA(c1, alpha);
+	fill->clip[0] = *((unsigned*)&mclip.xx);
+	fill->clip[1] = *((unsigned*)&mclip.xy);
+	fill->clip[2] = *((unsigned*)&mclip.xt);
+	fill->clip[3] = *((unsigned*)&mclip.yx);
+	fill->clip[4] = *((unsigned*)&mclip.yy);
+	fill->clip[5] = *((unsigned*)&mclip.yt);
+	fill->matrix[0] = *((unsigned*)&minv.xx);
+	fill->matrix[1] = *((unsigned*)&minv.xy);
+	fill->matrix[2] = *((unsigned*)&minv.xt);
+	fill->matrix[3] = *((unsigned*)&minv.yx);
+	fill->matrix[4] = *((unsigned*)&minv.yy);
+	fill->matrix[5] = *((unsigned*)&minv.yt);
+	fill->extent[0] = *((unsigned*)&e0);
+	fill->extent[1] = *((unsigned*)&e1);
+	fill->radius[0] = *((unsigned*)&r0);
+	fill->radius[1] = *((unsigned*)&r1);
+}
+
+static unsigned vg_push_block(const unsigned *block)
+{
+	unsigned hash; int i, slot, index;
+
+	// blocks are matched against a system memory copy, the data
+	// buffer may be write-combined GPU memory
+	hash = 2166136261u;
+	for (i = 0; i < VG_BLOCK_SIZE; i++)
+		hash = (hash ^ block[i]) * 16777619u;
+
+	for (i = 0; i < VG_BLOCK_PROBE; i++) {
+		slot = (hash + i) & (VG_BLOCK_SLOTS - 1);
+		if (!vg_block_index[slot]) break;
+		if (!memcmp(vg_block_words[slot], block, VG_BLOCK_SIZE * 4))
+			return vg_block_index[slot] - 1 + vg_data_base;
+	}
+
+	index = vg_data_count;
+	memcpy(&vg_data_buffer[index], block, VG_BLOCK_SIZE * 4);
+	vg_data_count += VG_BLOCK_SIZE;
+	vg.stats.headers += VG_BLOCK_SIZE * 4;
+
+	if (i < VG_BLOCK_PROBE) {
+		vg_block_index[slot] = index + 1;
+		memcpy(vg_block_words[slot], block, VG_BLOCK_SIZE * 4);
+	}
+	return index + vg_data_base;
+}
+
+static int vg_fill_clipped(vgFill *fill)
+{
+	vgFill none;
+	none.clip[0] = none.clip[1] = none.clip[3] = none.clip[4] = 0;
+	none.clip[2] = none.clip[5] = 0x3F000000; // 0.5f
+	return memcmp(fill->clip, none.clip, sizeof(none.clip)) != 0;
+}
+
+static void vg_push_entry(int data, int edges)
+{
+	assert(vg_entry_count < VG_MAX_ENTRIES);
+	vg_data_buffer[vg_entry_count * 2 + 0] = data  + vg_data_base;
+	vg_data_buffer[vg_entry_count * 2 + 1] = edges + vg_data_base;
+	vg_entry_data  = data;
+	vg_entry_edges = edges;
+	vg_entry_count++;
+}
+
+static int vg_push_header(vgFill *fill)
+{
+	unsigned header[VG_HEADER_GRAD];
+	int size;
+
+	size = VG_HEADER_WORDS(fill);
+
+	header[0] = fill->args;
+	header[1] = fill->color0;
+	header[2] = vg_fill_clipped(fill) ? vg_push_block(fill->clip) : VG_BLOCK_NONE;
+
+	if (size == VG_HEADER_GRAD) {
+		header[3] = fill->color1;
+		header[4] = vg_push_block(fill->matrix);
+		header[5] = fill->extent[0];
+		header[6] = fill->extent[1];
+		header[7] = fill->radius[0];
+		header[8] = fill->radius[1];
+	} else if (size == VG_HEADER_DASH) {
+		header[3] = vg_push_block(fill->matrix);
+		header[4] = fill->extent[0];
+	}
+
+	if (size != vg_header_size || memcmp(header, vg_header_words, size * 4)) {
+		vg_header_size  = size;
+		vg_header_index = vg_data_count;
+		memcpy(vg_header_words, header, size * 4);
+		memcpy(&vg_data_buffer[vg_data_count], header, size * 4);
+		vg_data_count += size;
+		vg.stats.headers += size * 4;
+	}
+
+	return vg_header_index;
+}
+
+static void vg_push_fill(vgFill *fill, int ntiles, int nedges)
+{
+	int size, isize, ientry;
+
+	// an edge takes at most three words: three points in lone edge strips, twice
+	// over when banded, or a slope edge. Heavy tiles hold at least VG_TILE_HEAVY
+	// words of strips and lead with the band starts, any tile may escape its
+	// sign into one more word.
+	size   = VG_HEADER_WORDS(fill);
+	isize  = size + VG_BLOCK_SIZE * 2 + nedges * 3 + nedges * 3 / 2 / VG_TILE_HEAVY * (VG_TILE_BANDS / 2) + ntiles;
+	ientry = 2 + isize / VG_TILE_OFFSET;
+
+	assert(ntiles <= VG_MAX_TILES);
+	assert(isize  <= VG_MAX_DATA - VG_ENTRY_WORDS);
+	assert(ientry <= VG_MAX_ENTRIES);
+
+	if (VGL_TILE_LISTS)
+		isize += (vg_tile_count + ntiles) * VG_LIST_WORDS + vg_grid_sizex * vg_grid_sizey;
+
+	// a fill starts at most one run, its tiles cover distinct screen tiles
+	if (vg_tile_count  + ntiles > VG_MAX_TILES ||
+		vg_entry_count + ientry > VG_MAX_ENTRIES ||
+		vg_data_count  + isize  > VG_MAX_DATA ||
+		(VGL_VARIANTS && vg_run_count >= VG_MAX_RUNS))
+		vg_flush();
+
+	vg_fill_variant = (fill->type != VG_FILL_FLAT) | (fill->spaa != 0) << 1;
+	vg_push_entry(vg_push_header(fill), vg_data_count);
+}
+
+#if VGL_GPU_BINNING
+static void vg_push_bin(vgFill *fill, int x, int y, int sizex, int sizey)
+{
+	unsigned *bin;
+	int cells, isize, reserve;
+
+	// lone edges take three points, plus padding and a two word record per tile
+	cells   = sizex * sizey;
+	isize   = VG_HEADER_GRAD + VG_BLOCK_SIZE * 2 + vg_bin_count * 3;
+	reserve = (vg_bin_edges * 3 + 1) / 2 + cells * 3;
+
+	assert(cells <= VG_MAX_TILES && cells <= VG_MAX_CELLS && sizey <= VG_MAX_ROWS);
+	assert(isize + reserve <= VG_MAX_DATA - VG_ENTRY_WORDS);
+
+	if (vg_tile_count  + cells > VG_MAX_TILES ||
+		vg_bin_cells   + cells > VG_MAX_CELLS ||
+		vg_bin_rows    + sizey > VG_MAX_ROWS ||
+		vg_entry_count + 1     > VG_MAX_BINS ||
+		vg_data_count  + isize + vg_bin_reserve + reserve > VG_MAX_DATA)
+		vg_flush();
+
+	bin = &vg_data_buffer[vg_entry_count++ * VG_BIN_WORDS];
+	bin[0] = vg_push_header(fill) + vg_data_base;
+	bin[1] = vg_data_count + vg_data_base;
+	bin[2] = vg_bin_total;
+	bin[3] = vg_bin_cells;
+	bin[4] = vg_bin_rows;
+	bin[5] = x | (y << 16);
+	bin[6] = sizex | (sizey << 16);
+	bin[7] = vg_bin_count;
+
+	memcpy(&vg_data_buffer[vg_data_count], vg_bin_points, vg_bin_count * 3 * sizeof(unsigned));
+	vg_data_count  += vg_bin_count * 3;
+	vg_bin_total   += vg_bin_count;
+	vg_bin_cells   += cells;
+	vg_bin_rows    += sizey;
+	vg_bin_reserve += reserve;
+	vg_tile_count  += cells;
+}
+
+static void vg_bin_point(float x, float y, int flags)
+{
+	unsigned *point;
+	assert(vg_bin_count < VG_MAX_EDGES);
+	point = &vg_bin_points[vg_bin_count++ * 3];
+	point[0] = *((unsigned*)&x);
+	point[1] = *((unsigned*)&y);
+	point[2] = flags;
+}
+
+// Bounds the edges a segment leaves in the grid: its span clipped to the grid
+// in tiles, both edges of every column crossed and the extra ones where long
+// segments are halved. Parts off the grid only carry sign or nothing.
+
+static int vg_bin_reach(vgPoint a, vgPoint b)
+{
+	float p[4], q[4], t, t0, t1;
+	int i, nx, ny;
+
+	p[0] = a.x - b.x; q[0] = a.x;
+	p[1] = b.x - a.x; q[1] = vg_grid_sizex * VG_TILE_DIMS - a.x;
+	p[2] = a.y - b.y; q[2] = a.y;
+	p[3] = b.y - a.y; q[3] = vg_grid_sizey * VG_TILE_DIMS - a.y;
+
+	t0 = 0;
+	t1 = 1;
+	for (i = 0; i < 4; i++) {
+		if (p[i] == 0) {
+			if (q[i] < 0)
+				return 0;
+			continue;
+		}
+		t = q[i] / p[i];
+		if (p[i] < 0)
+			t0 = t > t0 ? t : t0;
+		else
+			t1 = t < t1 ? t : t1;
+	}
+	if (t0 > t1)
+		return 0;
+
+	nx = (int)(fabsf(b.x - a.x) * (t1 - t0) / VG_TILE_DIMS) + 1;
+	ny = (int)(fabsf(b.y - a.y) * (t1 - t0) / VG_TILE_DIMS) + 1;
+	return nx * 2 + ny + 4 + (nx + ny) / 16;
+}
+#endif
+
+#if VGL_VARIANTS
+static vgTile* vg_stage_tile(int x, int y)
+{
+	int index, mark;
+
+	index = x + y * vg_grid_sizex;
+	mark = vg_tile_mark[index];
+	if (mark >> 2 == vg_run_stamp && (mark & 3) > vg_fill_variant) {
+		vg_run_start[vg_run_count++] = vg_tile_count;
+		vg_run_stamp++;
+	}
+	if (mark >> 2 != vg_run_stamp || (mark & 3) < vg_fill_variant)
+		vg_tile_mark[index] = vg_run_stamp << 2 | vg_fill_variant;
+
+	vg_tile_variant[vg_tile_count] = vg_fill_variant;
+	return &vg_tile_stage[vg_tile_count++];
+}
+#endif
+
+static void vg_push_tile(int x, int y, int sign, void *edges, int count)
+{
+	vgTile *tile;
+	int index, offset;
+
+	assert(vg_tile_count + 1 <= VG_MAX_TILES);
+
+	// a negative count marks a banded tile
+	index = (int)((unsigned*)edges - vg_data_buffer);
+	vg_data_count += count < 0 ? -count : count;
+
+	if (count < 0 || count >= VG_TILE_ESCAPE || sign < -128 || sign > 127) {
+		count = count < 0 ? -count | VG_TILE_BANDED : count;
+		vg_data_buffer[vg_data_count] = (sign & 0xFFFF) | (count << 16);
+		index = vg_data_count++;
+		count = VG_TILE_ESCAPE;
+		sign  = 0;
+	}
+
+	offset = count ? index - vg_entry_edges : 0;
+	if (offset >= VG_TILE_OFFSET) {
+		vg_push_entry(vg_entry_data, index);
+		offset = 0;
+	}
+
+#if VGL_VARIANTS
+	tile = vg_stage_tile(x, y);
+#elif VGL_TILE_LISTS
+	tile = &vg_tile_storage[vg_tile_count++];
+#else
+	tile = &vg_tile_buffer[vg_tile_count++];
+#endif
+	tile->coord = x | (y << 12) | ((unsigned)sign << 24);
+	tile->edges = count | (offset << 8) | ((vg_entry_count - 1) << 18);
+}
+
+static void vg_batch_touch(int index)
+{
+	if (vg_batch_count < VG_MAX_EDGES)
+		vg_batch_cells[vg_batch_count].index = index;
+	vg_batch_count++;
+}
+
+static void vg_push_bounds(float x, float y)
+{
+	int ix, iy; vgRect bb;
+	ix = (int)(x / VG_TILE_DIMS);
+	iy = (int)(y / VG_TILE_DIMS);
+	bb = vg_grid_bounds;
+	vg_grid_bounds.minx = bb.minx < ix ? bb.minx : ix;
+	vg_grid_bounds.miny = bb.miny < iy ? bb.miny : iy;
+	vg_grid_bounds.maxx = bb.maxx > ix ? bb.maxx : ix;
+	vg_grid_bounds.maxy = bb.maxy > iy ? bb.maxy : iy;
+}
+
+static void vg_push_edge(int ix, int iy, int ax, int ay, int bx, int by)
+{
+	int index, previd, edgeid;
+	vgEdge edge;
+
+	if (vg_edge_count >= VG_MAX_EDGES  ||
+		(ax == bx && ay == by)         ||
+		ix < 0 || ix >= vg_grid_sizex  ||
+		iy < 0 || iy >= vg_grid_sizey)
+		return;
+
+	vg.stats.edges++;
+
+	index  = ix + iy * vg_grid_sizex;
+	previd = vg_tile_edge[index];
+	edgeid = vg_edge_count;
+
+	if (vg_batch_active && !previd && !vg_tile_sign[index])
+		vg_batch_touch(index);
+
+	if (vg_fill_winding > 0) {
+		edge.x0 = ax - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.y0 = ay - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.x1 = bx - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.y1 = by - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
+	} else {
+		edge.x0 = bx - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.y0 = by - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.x1 = ax - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER;
+		edge.y1 = ay - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER;
+	}
+
+	vg_edge_buffer[edgeid] = edge;
+	vg_edge_links[edgeid] = previd;
+	vg_tile_edge[index] = edgeid;
+
+	vg_edge_count++;
+}
+
+static void vg_push_sign(int ix, int iy, int sign)
+{
+	int index;
+
+	if (iy >= vg_grid_sizey || iy < 0 ||
+		ix >= vg_grid_sizex)
+		return;
+
+	if (ix < 0)
+		ix = 0;
+
+	index = ix + iy * vg_grid_sizex;
+	if (vg_batch_active && !vg_tile_sign[index] && !vg_tile_edge[index])
+		vg_batch_touch(index);
+	vg_tile_sign[index] -= sign * vg_fill_winding;
+}
+
+static void vg_push_sign_span(int iy0, int iy1)
+{
+	int dy, sv, sw;
+	signed char *sp, *se;
+
+	iy0 = iy0 < 0 ? 0 : iy0 >= vg_grid_sizey ? vg_grid_sizey - 1 : iy0;
+	iy1 = iy1 < 0 ? 0 : iy1 >= vg_grid_sizey ? vg_grid_sizey - 1 : iy1;
+
+	dy = iy1 - iy0;
+	sw = vg_grid_sizex;
+
+	if (dy > 0) {
+		sp = &vg_tile_sign[iy0 * sw];
+		se = sp + dy * sw;
+		sv = -vg_fill_winding;
+	} else
+	if (dy < 0) {
+		sp = &vg_tile_sign[iy1 * sw];
+		se = sp - dy * sw;
+		sv = +vg_fill_winding;
+	} else {
+		return;
+	}
+
+	while (sp != se) {
+		if (vg_batch_active && !*sp && !vg_tile_edge[sp - vg_tile_sign])
+			vg_batch_touch((int)(sp - vg_tile_sign));
+		*sp += sv;
+		sp += sw;
+	}
+}
+
+static int vg_fill_closed()
+{
+	return
+		vg_fill_point.x == vg_fill_start.x &&
+		vg_fill_point.y == vg_fill_start.y;
+}
+
+static void vg_fill_close()
+{
+	if (!vg_fill_reset && !vg_fill_closed())
+		vg_fill_lineto(vg_fill_start.x - VG_TILE_DIMS, vg_fill_start.y);
+	vg_fill_reset = 1;
+}
+
+static void vg_fill_moveto_base(float x, float y)
+{
+	vg_fill_reset = 0;
+	vg_fill_start.x = x;
+	vg_fill_start.y = y;
+	vg_fill_point.x = x;
+	vg_fill_point.y = y;
+	vg_push_bounds(x, y);
+#if VGL_GPU_BINNING
+	vg_bin_point(x, y, VG_BIN_START);
+#endif
+}
+
+static void vg_fill_moveto(float x, float y)
+{
+	vg_fill_moveto_base(x + VG_TILE_DIMS, y);
+}
+
+static void vg_fill_lineto_base(float x, float y)
+{
+	int dx, dy, lx, ly, tx, ty;
+	int tx0, ty0, tx1, ty1;
+	int ix0, iy0, ix1, iy1;
+	int x0, y0, x1, y1;
+	int sx, sy, fx, fy;
+	int ex, ey, er;
+	int nx, ny, ni;
+
+	if (vg_fill_reset) {
+		vg_fill_moveto_base(x, y);
+		return;
+	}
+
+	// TODO: clip line?
+
+	x0 = (int)(vg_fill_point.x * VG_PIXEL_SIZE);
+	y0 = (int)(vg_fill_point.y * VG_PIXEL_SIZE);
+	x1 = (int)(x * VG_PIXEL_SIZE);
+	y1 = (int)(y * VG_PIXEL_SIZE);
+
+	if (x0 == x1 && y0 == y1)
+		return;
+
+	ix0 = x0 >> VG_TILE_LOG2;
+	iy0 = y0 >> VG_TILE_LOG2;
+	ix1 = x1 >> VG_TILE_LOG2;
+	iy1 = y1 >> VG_TILE_LOG2;
+
+#if VGL_GPU_BINNING
+	vg_bin_edges += vg_bin_reach(vg_fill_point, (vgPoint) { x, y });
+	vg_bin_point(x, y, vg_fill_winding > 0 ? 0 : VG_BIN_NEGATIVE);
+	goto pass;
+#endif
+
+	if ((iy0 < 0 && iy1 < 0) ||
+		(ix0 > vg_grid_sizex && ix1 > vg_grid_sizex) ||
+		(iy0 > vg_grid_sizey && iy1 > vg_grid_sizey)) {
+		goto pass;
+	}
+
+	if (x0 < 0 && x1 < 0) {
+		vg_push_sign_span(iy0, iy1);
+		goto pass;
+	}
+
+	dx = abs(x1 - x0);
+	dy = abs(y1 - y0);
+
+	if (dx >= (64 << VG_TILE_LOG2) ||
+		dy >= (64 << VG_TILE_LOG2)) {
+		vg_fill_lineto_base(
+			(vg_fill_point.x + x) * 0.5f,
+			(vg_fill_point.y + y) * 0.5f);
+		vg_fill_lineto_base(x, y);
+		return;
+	}
+
+	nx = abs(ix1 - ix0);
+	ny = abs(iy1 - iy0);
+	ni = nx + ny;
+
+	sx = x1 >= x0 ? 1 : -1;
+	sy = y1 >= y0 ? 1 : -1;
+	lx = dy > 0 ? (dx << VG_EDGE_LOG2 << VG_TILE_LOG2) / dy * sx : 0;
+	ly = dx > 0 ? (dy << VG_EDGE_LOG2 << VG_TILE_LOG2) / dx * sy : 0;
+	fx = ((sx > 0 ? VG_TILE_MASK - x0 : x0) & VG_TILE_MASK);
+	fy = ((sy > 0 ? VG_TILE_MASK - y0 : y0) & VG_TILE_MASK);
+	tx = (lx * (fy << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
+	ty = (ly * (fx << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
+
+	tx0 = tx1 = x0;
+	ty0 = ty1 = y0;
+	ix1 = ix0;
+	iy1 = iy0;
+
+	ex = -(dy << VG_TILE_LOG2);
+	ey =  (dx << VG_TILE_LOG2);
+	er =  (dx * (fy + 1)) - (dy * (fx + 1));
+
+	// TODO: preallocate edges? (ni + nx * 2)
+
+	while (ni-- >= 0) {
+		tx0 = tx1;
+		ty0 = ty1;
+		ix0 = ix1;
+		iy0 = iy1;
+
+		if (ni == -1) {
+			tx1 = x1;
+			ty1 = y1;
+		} else
+			if (er > 0) {
+				tx1 = ((ix0 + (sx > 0)) << VG_TILE_LOG2);
+				ty1 = y0 + (ty >> VG_EDGE_LOG2);
+
+				er += ex;
+				ty += ly;
+				ix1 += sx;
+
+				if (sx > 0)
+					vg_push_edge(ix1, iy1, tx1 - 32, (iy1 << VG_TILE_LOG2), tx1 - 32, ty1);
+				else
+					vg_push_edge(ix0, iy0, tx1 - 32, ty1, tx1 - 32, (iy0 << VG_TILE_LOG2));
+			} else {
+				tx1 = x0 + (tx >> VG_EDGE_LOG2);
+				ty1 = ((iy0 + (sy > 0)) << VG_TILE_LOG2);
+
+				er += ey;
+				tx += lx;
+				iy1 += sy;
+
+				if (sy > 0)
+					vg_push_sign(ix0, iy0, +1);
+				else
+					vg_push_sign(ix1, iy1, -1);
+			}
+
+		vg_push_edge(ix0, iy0, tx0, ty0, tx1, ty1);
+	}
+
+pass:
+	vg_fill_point.x = x;
+	vg_fill_point.y = y;
+	vg_push_bounds(x, y);
+}
+
+static void vg_fill_lineto(float x, float y)
+{
+	vg_fill_lineto_base(x + VG_TILE_DIMS, y);
+}
+
+// Tile edges are uploaded as strips of 16 bit points (x, y), every point closing
+// an edge from the one before. Repeating a point ends the strip, the next starts
+// another. Tile lists hold a contour in reverse, or forward when the winding
+// swapped its edges, so runs are joined in either direction. Runs meeting at the
+// same height are joined through a horizontal edge, which covers no area.
+
+#define VG_POINT_A(e) ((e).packed & 0xFFFF)
+#define VG_POINT_B(e) ((e).packed >> 16)
+
+static int vg_fill_runs(unsigned *data, vgEdge *edges, int count)
+{
+	unsigned short *points;
+	unsigned a, b, last;
+	int index, end, step, size, link, i;
+
+	points = vg_strip_points;
+	size = 0;
+	for (index = 0; index < count; index = end + 1) {
+		end = index;
+		step = 0;
+		while (end + 1 < count) {
+			if (step >= 0 && VG_POINT_B(edges[end]) >> 8 == VG_POINT_A(edges[end + 1]) >> 8)
+				step = 1;
+			else if (step <= 0 && VG_POINT_A(edges[end]) >> 8 == VG_POINT_B(edges[end + 1]) >> 8)
+				step = -1;
+			else
+				break;
+			end++;
+		}
+
+		if (size > 0) {
+			points[size] = points[size - 1];
+			size++;
+		}
+
+		link = step >= 0 ? index : end;
+		step = step >= 0 ? 1 : -1;
+		last = ~0u;
+		for (i = index; i <= end; i++, link += step) {
+			a = VG_POINT_A(edges[link]);
+			b = VG_POINT_B(edges[link]);
+			if (a != last)
+				points[size++] = a;
+			points[size++] = b;
+			last = b;
+		}
+	}
+
+	if (size & 1) {
+		points[size] = points[size - 1];
+		size++;
+	}
+
+	memcpy(data, points, size * sizeof(short));
+	return size / 2;
+}
+
+// Bands split the tile rows evenly, an edge goes to every band it overlaps.
+// Returns the negated word count, or keeps the plain strips of the last
+// vg_fill_strips when edges would repeat in more than half the bands on
+// average, and rewrites them when no band comes out shorter. A banded tile
+// so takes at most twice the words of lone edge strips, plus the starts.
+
+static int vg_band_overlaps(vgEdge edge, int band)
+{
+	int lo, hi;
+	lo = VG_EDGE_BORDER + band * (VG_TILE_SIZE / VG_TILE_BANDS);
+	hi = lo + VG_TILE_SIZE / VG_TILE_BANDS;
+	return (edge.y0 < edge.y1 ? edge.y0 : edge.y1) < hi && (edge.y0 > edge.y1 ? edge.y0 : edge.y1) > lo;
+}
+
+static int vg_fill_bands(unsigned *data, int count, int plain)
+{
+	unsigned short *starts;
+	int band, index, size, n, longest;
+
+	for (band = n = 0; band < VG_TILE_BANDS; band++)
+		for (index = 0; index < count; index++)
+			n += vg_band_overlaps(vg_strip_edges[index], band);
+	if (n > count * VG_TILE_BANDS / 2)
+		return plain;
+
+	starts  = (unsigned short*)data;
+	size    = VG_TILE_BANDS / 2;
+	longest = 0;
+
+	for (band = 0; band < VG_TILE_BANDS; band++) {
+		for (index = n = 0; index < count; index++)
+			if (vg_band_overlaps(vg_strip_edges[index], band))
+				vg_band_edges[n++] = vg_strip_edges[index];
+		starts[band] = (unsigned short)size;
+		n = vg_fill_runs(data + size, vg_band_edges, n);
+		longest = longest > n ? longest : n;
+		size += n;
+	}
+
+	if (longest >= plain)
+		return vg_fill_runs(data, vg_strip_edges, count);
+	return -size;
+}
+
+// Slope edges take three words: the edge and its reciprocal slopes dx/dy, dy/dx.
+// Tiles hold few edges, an insertion sort orders them by their top.
+
+#define VG_EDGE_TOP(e) ((e).y0 < (e).y1 ? (e).y0 : (e).y1)
+
+static int vg_fill_slopes(unsigned *data, vgEdge *edges, int count)
+{
+	vgEdge edge;
+	float dx, dy, lx, ly;
+	int i, j;
+
+	for (i = 1; i < count; i++) {
+		edge = edges[i];
+		for (j = i; j > 0 && VG_EDGE_TOP(edges[j - 1]) > VG_EDGE_TOP(edge); j--)
+			edges[j] = edges[j - 1];
+		edges[j] = edge;
+	}
+
+	for (i = 0; i < count; i++) {
+		dx = (float)edges[i].x1 - (float)edges[i].x0;
+		dy = (float)edges[i].y1 - (float)edges[i].y0;
+		lx = dx / dy;
+		ly = dy / dx;
+		data[i * 3 + 0] = edges[i].packed;
+		data[i * 3 + 1] = *((unsigned*)&lx);
+		data[i * 3 + 2] = *((unsigned*)&ly);
+	}
+
+	return count * 3;
+}
+
+// Dash segments take two words: the segment and its arc length.
+
+static int vg_fill_dashes(unsigned *data, int link)
+{
+	int count;
+
+	for (count = 0; link; count++) {
+		data[count * 2 + 0] = vg_edge_buffer[link].packed;
+		data[count * 2 + 1] = *((unsigned*)&vg_edge_arcs[link]);
+		link = vg_edge_links[link];
+	}
+
+	return count * 2;
+}
+
+static int vg_fill_strips(unsigned *data, int link)
+{
+	int count, size, bucket;
+
+	if (vg_fill_lines == VG_DASH)
+		return vg_fill_dashes(data, link);
+
+	for (count = 0; link; count++) {
+		vg_strip_edges[count] = vg_edge_buffer[link];
+		link = vg_edge_links[link];
+	}
+
+	if (VGL_EDGE_SLOPES)
+		size = vg_fill_slopes(data, vg_strip_edges, count);
+	else
+		size = vg_fill_runs(data, vg_strip_edges, count);
+	if (size == 0)
+		return 0;
+
+	for (bucket = 1; bucket < VG_HISTOGRAM - 1 && size >> bucket; bucket++);
+	vg.stats.histogram[bucket]++;
+
+	// sorted slope edges already stop at the pixel's row, lines reach past their band
+	return size >= VG_TILE_HEAVY && !VGL_EDGE_SLOPES && !vg_fill_lines ? vg_fill_bands(data, count, size) : size;
+}
+
+static void vg_fill_draw(vgFill *fill)
+{
+	vgRect rect;
+	unsigned *edges;
+	int index, sign, x, y;
+	int sizex, sizey, count;
+
+	rect = vg_grid_bounds;
+	if (rect.minx > rect.maxx)
+		return;
+
+	rect.minx -= 1;
+	rect.maxx += 1;
+	rect.maxy += 1;
+	rect = vg_rect_clamp(rect, (vgRect) { 0, 0, vg_grid_sizex - 1, vg_grid_sizey - 1 });
+
+	sizex = rect.maxx - rect.minx - 1;
+	sizey = rect.maxy - rect.miny;
+
+	if (sizex <= 0 || sizey <= 0)
+		return;
+
+#if VGL_GPU_BINNING
+	vg_push_bin(fill, rect.minx, rect.miny, sizex + 1, sizey);
+	return;
+#endif
+
+	vg_push_fill(fill, sizex * sizey, vg_edge_count - 1);
+
+	for (y = 0; y < sizey; y++) {
+		sign = 0;
+		index = rect.minx + (rect.miny + y) * vg_grid_sizex;
+		for (x = 0; x <= sizex; x++, index++) {
+			if (x > 0) {
+				edges = &vg_data_buffer[vg_data_count];
+				count = vg_fill_strips(edges, vg_tile_edge[index]);
+				if (sign != 0 || count != 0) {
+					vg.stats.histogram[0] += count == 0;
+					vg_push_tile(
+						rect.minx + x - 1,
+						rect.miny + y,
+						sign, edges, count);
+				}
+			}
+			sign += vg_tile_sign[index];
+			vg_tile_sign[index] = 0;
+			vg_tile_edge[index] = 0;
+		}
+	}
+}
+
+static void vg_fill_base(vgFill *fill)
+{
+	vgPoint point;
+	vgPath path;
+	int index;
+
+	vg_fill_begin();
+
+	for (index = 0; index < vg_path_count;) {
+		path = vg_path_buffer[index++];
+		point = vg_path_buffer[index++].point;
+		vg_fill_winding = path.winding ? 1 : -1;
+		vg_fill_moveto(point.x, point.y);
+		while (index < path.end) {
+			point = vg_path_buffer[index++].point;
+			vg_fill_lineto(point.x, point.y);
+		}
+	}
+
+	vg_fill_close();
+	vg_fill_draw(fill);
+}
+
+// Fills every tile of a device space box from its sign alone, leaving the
+// current path untouched. Binned signs come from edges, the box is outlined.
+
+static void vg_fill_tiles(vgFill *fill, float x0, float y0, float x1, float y1)
+{
+	int ix0, iy0, ix1, iy1, iy;
+
+	assert(!vg_path_stream);
+	vg_fill_reset = 1;
+	vg_fill_winding = 1;
+	vg_fill_empty();
+
+#if VGL_GPU_BINNING
+	vg_fill_moveto(x0, y0);
+	vg_fill_lineto(x1, y0);
+	vg_fill_lineto(x1, y1);
+	vg_fill_lineto(x0, y1);
+	vg_fill_close();
+	vg_fill_draw(fill);
+	return;
+#endif
+
+	// grid columns are shifted right by the sign column
+	ix0 = (int)floorf(x0 / VG_TILE_DIMS) + 1;
+	ix1 = (int)floorf(x1 / VG_TILE_DIMS) + 1;
+	iy0 = (int)floorf(y0 / VG_TILE_DIMS);
+	iy1 = (int)floorf(y1 / VG_TILE_DIMS);
+	ix0 = ix0 < 1 ? 1 : ix0;
+	iy0 = iy0 < 0 ? 0 : iy0;
+	ix1 = ix1 > vg_grid_sizex - 2 ? vg_grid_sizex - 2 : ix1;
+	iy1 = iy1 > vg_grid_sizey - 2 ? vg_grid_sizey - 2 : iy1;
+	if (ix0 > ix1 || iy0 > iy1)
+		return;
+
+	for (iy = iy0; iy <= iy1; iy++)
+		vg_tile_sign[ix0 - 1 + iy * vg_grid_sizex] = 1;
+
+	vg_grid_bounds.minx = ix0;
+	vg_grid_bounds.miny = iy0;
+	vg_grid_bounds.maxx = ix1;
+	vg_grid_bounds.maxy = iy1;
+	vg_fill_draw(fill);
+}
+
+void vg_fill(unsigned color)
+{
+	vgFill fill;
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_FLAT, color, color, 0, 0, 0, 0, &vg.state.matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillr(unsigned c0, unsigned c1, float x, float y, float r0, float r1)
+{
+	vgMatrix matrix;
+	vgFill fill;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD, c0, c1, 0, 0, r0, r1, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillrh(float x, float y, float r0, float r1, float sat, float val)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD_HUE, 0xFFFFFFFF, 0xFFFFFFFF, sat, val, r0, r1, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillrs(float x, float y, float r0, float r1, float hue)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD_SAT, 0xFFFFFFFF, 0xFFFFFFFF, hue, 0, r0, r1, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillb(unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x + w / 2, y + h / 2);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX, c0, c1, w / 2, h / 2, r0, r1, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillg(unsigned c0, unsigned c1, float x0, float y0, float x1, float y1)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x0, y0);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_LIN, c0, c1, x1 - x0, y1 - y0, 0, 0, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillbh(float x, float y, float w, float h, float sat, float val)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_matrix_scale(matrix.v, w, h);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX_HUE, 0xFFFFFFFF, 0xFFFFFFFF, sat, val, 0, 0, &matrix);
+	vg_fill_base(&fill);
+}
+
+void vg_fillbs(float x, float y, float w, float h, float hue)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_matrix_scale(matrix.v, w, h);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX_SAT, 0xFFFFFFFF, 0xFFFFFFFF, hue, 0, 0, 0, &matrix);
+	vg_fill_base(&fill);
+}
+
+// Draws the shadow of a rounded box, blurred by a Gaussian of deviation blur / 2
+// as CSS box shadows are. It is evaluated in closed form per pixel over the tiles
+// it reaches, the current path is kept.
+
+void vg_shadow(float x, float y, float w, float h, float radius, float blur, unsigned color)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	float sigma, reach, px[4], py[4], x0, y0, x1, y1;
+	int i;
+
+	sigma = blur > 0 ? blur / 2 : 0;
+	reach = sigma * 3;
+	radius = radius < w / 2 ? radius : w / 2;
+	radius = radius < h / 2 ? radius : h / 2;
+	radius = radius > 0 ? radius : 0;
+
+	px[0] = px[3] = x - reach; px[1] = px[2] = x + w + reach;
+	py[0] = py[1] = y - reach; py[2] = py[3] = y + h + reach;
+	for (i = 0; i < 4; i++)
+		vg_project(&px[i], &py[i]);
+	x0 = x1 = px[0];
+	y0 = y1 = py[0];
+	for (i = 1; i < 4; i++) {
+		x0 = px[i] < x0 ? px[i] : x0;
+		y0 = py[i] < y0 ? py[i] : y0;
+		x1 = px[i] > x1 ? px[i] : x1;
+		y1 = py[i] > y1 ? py[i] : y1;
+	}
+
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x + w / 2, y + h / 2);
+	vg_fill_set(&fill, VG_NONZERO, VG_FILL_SHADOW, color, color, w / 2, h / 2, radius, sigma, &matrix);
+	// pad for the deviation kept at half a pixel to smooth hard edges
+	vg_fill_tiles(&fill, x0 - 2, y0 - 2, x1 + 2, y1 + 2);
+}
+
+void vg_fillgr(unsigned c0, unsigned c1, float x, float y, float w, float h, float r)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_GRID, c0, c1, w, h, r, 0, &matrix);
+	vg_fill_base(&fill);
+}
+
+unsigned long long vg_ramp_keys[VG_MAX_RAMPS];
+int                vg_ramp_count;
+unsigned           vg_ramp_texels[VG_RAMP_SIZE];
+
+// Stops are offsets in [0, 1] in increasing order, spread evenly when NULL. The
+// colors are interpolated per channel as between color0 and color1.
+
+static int vg_ramp(const unsigned *colors, const float *stops, int n)
+{
+	unsigned long long key;
+	unsigned c0, c1, texel;
+	float t, s0, s1, f;
+	int i, j, k, c;
+
+	key = 14695981039346656037ull;
+	for (i = 0; i < n; i++) {
+		key = (key ^ colors[i]) * 1099511628211ull;
+		key = (key ^ (stops ? *((unsigned*)&stops[i]) : (unsigned)i)) * 1099511628211ull;
+	}
+
+	for (i = 0; i < vg_ramp_count; i++) {
+		if (vg_ramp_keys[i] == key)
+			return i + 1;
+	}
+
+	// rows are only rewritten once the fills sampling them are drawn
+	if (vg_ramp_count == VG_MAX_RAMPS) {
+		vg_flush();
+		vg_ramp_count = 0;
+	}
+
+	for (i = j = 0; i < VG_RAMP_SIZE; i++) {
+		t = i / (float)(VG_RAMP_SIZE - 1);
+		while (j < n - 1 && (stops ? stops[j + 1] : (j + 1) / (float)(n - 1)) < t)
+			j++;
+		k  = j < n - 1 ? j + 1 : j;
+		s0 = stops ? stops[j] : n > 1 ? j / (float)(n - 1) : 0;
+		s1 = stops ? stops[k] : n > 1 ? k / (float)(n - 1) : 0;
+		f  = s1 > s0 ? (t - s0) / (s1 - s0) : t >= s1;
+		f  = f < 0 ? 0 : f > 1 ? 1 : f;
+		c0 = colors[j];
+		c1 = colors[k];
+		for (c = 0, texel = 0; c < 32; c += 8)
+			texel |= (unsigned)(((c0 >> c) & 0xFF) * (1 - f) + ((c1 >> c) & 0xFF) * f + 0.5f) << c;
+		vg_ramp_texels[i] = texel;
+	}
+
+	vg_driver_ramp(vg_ramp_count, vg_ramp_texels);
+	vg.stats.upload += sizeof(vg_ramp_texels);
+	vg_ramp_keys[vg_ramp_count] = key;
+	return ++vg_ramp_count;
+}
+
+void vg_fillgn(const unsigned *colors, const float *stops, int n, float x0, float y0, float x1, float y1)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	if (n <= 0) return;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x0, y0);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_LIN, 0xFFFFFFFF, 0xFFFFFFFF, x1 - x0, y1 - y0, 0, 0, &matrix);
+	fill.rsv1 = (char)vg_ramp(colors, stops, n);
+	vg_fill_base(&fill);
+}
+
+void vg_fillrn(const unsigned *colors, const float *stops, int n, float x, float y, float r0, float r1)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	if (n <= 0) return;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x, y);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_RAD, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0, r0, r1, &matrix);
+	fill.rsv1 = (char)vg_ramp(colors, stops, n);
+	vg_fill_base(&fill);
+}
+
+void vg_fillbn(const unsigned *colors, const float *stops, int n, float x, float y, float w, float h, float r0, float r1)
+{
+	vgFill fill;
+	vgMatrix matrix;
+	if (n <= 0) return;
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, x + w / 2, y + h / 2);
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_BOX, 0xFFFFFFFF, 0xFFFFFFFF, w / 2, h / 2, r0, r1, &matrix);
+	fill.rsv1 = (char)vg_ramp(colors, stops, n);
+	vg_fill_base(&fill);
+}
+
+// Batch fills bin every item into the shared grid and take the cells it touched
+// before the next one starts, so items sharing tiles don't interleave. Tiles are
+// emitted per item in paint order from its sorted cells, walking the runs in
+// between from the sign alone. The GPU bins on its own and gets plain fills.
+
+static void vg_fill_item(vgFill *fill, const vgFillItem *item, const vgFill *flat)
+{
+	vgMatrix matrix;
+	const float *v;
+
+	v = item->v;
+	matrix = vg.state.matrix;
+	switch (item->type) {
+	case VG_ITEM_LINEAR:
+		vg_matrix_translate(matrix.v, v[0], v[1]);
+		vg_fill_set(fill, vg.state.mode, VG_FILL_LIN, item->color0, item->color1, v[2] - v[0], v[3] - v[1], 0, 0, &matrix);
+		break;
+	case VG_ITEM_RADIAL:
+		vg_matrix_translate(matrix.v, v[0], v[1]);
+		vg_fill_set(fill, vg.state.mode, VG_FILL_RAD, item->color0, item->color1, 0, 0, v[2], v[3], &matrix);
+		break;
+	case VG_ITEM_BOX:
+		vg_matrix_translate(matrix.v, v[0] + v[2] / 2, v[1] + v[3] / 2);
+		vg_fill_set(fill, vg.state.mode, VG_FILL_BOX, item->color0, item->color1, v[2] / 2, v[3] / 2, v[4], v[5], &matrix);
+		break;
+	default:
+		// flat fills only differ in color, the state alpha is in the template
+		*fill = *flat;
+		fill->color0 = VG_ALPHA(item->color0, VG_A(flat->color0));
+		fill->color1 = fill->color0;
+		break;
+	}
+}
+
+// Bins the subpaths of an item, resuming from the subpath reached by the one
+// before. Items are expected in path order, one going back restarts the walk.
+
+static void vg_batch_bin(const vgFillItem *item, int *index, int *subpath)
+{
+	vgPoint point;
+	vgPath path;
+	int i;
+
+	if (item->first < *subpath) {
+		*index = 0;
+		*subpath = 0;
+	}
+	for (; *subpath < item->first && *index < vg_path_count; (*subpath)++)
+		*index = vg_path_buffer[*index].end;
+
+	vg_fill_reset = 1;
+	vg_grid_bounds = (vgRect) { vg_grid_sizex, vg_grid_sizey, 0, 0 };
+
+	i = *index;
+	for (; *subpath < item->first + item->count && i < vg_path_count; (*subpath)++) {
+		path = vg_path_buffer[i++];
+		point = vg_path_buffer[i++].point;
+		vg_fill_winding = path.winding ? 1 : -1;
+		vg_fill_moveto(point.x, point.y);
+		while (i < path.end) {
+			point = vg_path_buffer[i++].point;
+			vg_fill_lineto(point.x, point.y);
+		}
+		*index = i;
+	}
+
+	vg_fill_close();
+}
+
+// Snapshots and clears the cells touched since first, dropping repeats and the
+// ones left empty. Returns how many remain.
+
+static int vg_batch_take(int first)
+{
+	vgBatchCell *cell;
+	int i, index, count;
+
+	count = first;
+	for (i = first; i < vg_batch_count; i++) {
+		index = vg_batch_cells[i].index;
+		if (!vg_tile_edge[index] && !vg_tile_sign[index])
+			continue;
+		cell = &vg_batch_cells[count++];
+		cell->index = index;
+		cell->edge  = vg_tile_edge[index];
+		cell->sign  = vg_tile_sign[index];
+		vg_tile_sign[index] = 0;
+		vg_tile_edge[index] = 0;
+	}
+
+	vg_batch_count = count;
+	return count - first;
+}
+
+static void vg_batch_clear()
+{
+	memset(vg_tile_sign, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_sign[0]));
+	memset(vg_tile_edge, 0, vg_grid_sizex * vg_grid_sizey * sizeof(vg_tile_edge[0]));
+}
+
+static int vg_batch_compare(const void *a, const void *b)
+{
+	return ((const vgBatchCell*)a)->index - ((const vgBatchCell*)b)->index;
+}
+
+static void vg_batch_inside(int x0, int x1, int y, int sign)
+{
+	int x;
+
+	if (sign == 0)
+		return;
+
+	for (x = x0; x < x1; x++) {
+		vg.stats.histogram[0]++;
+		vg_push_tile(x - 1, y, sign, &vg_data_buffer[vg_data_count], 0);
+	}
+}
+
+// Emits the tiles of an item as vg_fill_draw would from the grid
+
+static void vg_batch_tiles(vgFill *fill, vgBatchItem *item)
+{
+	vgBatchCell *cell, *end;
+	vgRect rect;
+	unsigned *edges;
+	int sign, col, x, y;
+	int sizex, sizey, count;
+
+	rect = item->bounds;
+	if (rect.minx > rect.maxx)
+		return;
+
+	rect.minx -= 1;
+	rect.maxx += 1;
+	rect.maxy += 1;
+	rect = vg_rect_clamp(rect, (vgRect) { 0, 0, vg_grid_sizex - 1, vg_grid_sizey - 1 });
+
+	sizex = rect.maxx - rect.minx - 1;
+	sizey = rect.maxy - rect.miny;
+
+	if (sizex <= 0 || sizey <= 0)
+		return;
+
+	vg_push_fill(fill, sizex * sizey, item->edges);
+
+	cell = &vg_batch_cells[item->first];
+	end  = cell + item->count;
+	qsort(cell, item->count, sizeof(vgBatchCell), vg_batch_compare);
+
+	for (y = rect.miny; y < rect.maxy; y++) {
+		sign = 0;
+		x = rect.minx + 1;
+		for (; cell != end && cell->index < (y + 1) * vg_grid_sizex; cell++) {
+			col = cell->index - y * vg_grid_sizex;
+			if (col < rect.minx || col >= rect.maxx)
+				continue;
+			if (col > rect.minx) {
+				vg_batch_inside(x, col, y, sign);
+				edges = &vg_data_buffer[vg_data_count];
+				count = vg_fill_strips(edges, cell->edge);
+				if (sign != 0 || count != 0) {
+					vg.stats.histogram[0] += count == 0;
+					vg_push_tile(col - 1, y, sign, edges, count);
+				}
+				x = col + 1;
+			}
+			sign += cell->sign;
+		}
+		vg_batch_inside(x, rect.maxx, y, sign);
+	}
+}
+
+static void vg_batch_draw(const vgFillItem *items, const vgFill *flat)
+{
+	vgFill fill;
+	int i;
+
+	for (i = 0; i < vg_batch_pending; i++) {
+		vg_fill_item(&fill, &items[vg_batch_items[i].item], flat);
+		vg_batch_tiles(&fill, &vg_batch_items[i]);
+	}
+
+	vg_batch_pending = 0;
+	vg_batch_count = 0;
+	vg_edge_count = 1;
+}
+
+void vg_fill_batch(const vgFillItem *items, int n)
+{
+	vgBatchItem *pending;
+	vgFill fill, flat;
+	int i, index, subpath, first, edges, start, part, counted;
+
+	vg_fill_begin();
+	vg_fill_set(&flat, vg.state.mode, VG_FILL_FLAT, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0, 0, 0, &vg.state.matrix);
+
+	index = 0;
+	subpath = 0;
+
+#if VGL_GPU_BINNING
+	for (i = 0; i < n; i++) {
+		vg_fill_empty();
+		vg_batch_bin(&items[i], &index, &subpath);
+		vg_fill_item(&fill, &items[i], &flat);
+		vg_fill_draw(&fill);
+	}
+	return;
+#endif
+
+	vg_batch_active = 1;
+
+	for (i = 0; i < n; i++) {
+		if (vg_batch_pending == VG_BATCH_ITEMS)
+			vg_batch_draw(items, &flat);
+
+		start = index;
+		part  = subpath;
+		first = vg_batch_count;
+		edges = vg_edge_count;
+		counted = vg.stats.edges;
+		vg_batch_bin(&items[i], &index, &subpath);
+
+		// out of cells or edges, draw what is pending and bin the item again
+		if ((vg_batch_count > VG_MAX_EDGES || vg_edge_count >= VG_MAX_EDGES) && vg_batch_pending > 0) {
+			vg_batch_clear();
+			vg_batch_draw(items, &flat);
+			index = start;
+			subpath = part;
+			first = 0;
+			edges = 1;
+			vg.stats.edges = counted;
+			vg_batch_bin(&items[i], &index, &subpath);
+		}
+
+		// a lone item too large for the cell list is drawn from the grid
+		if (vg_batch_count > VG_MAX_EDGES) {
+			vg_fill_item(&fill, &items[i], &flat);
+			vg_fill_draw(&fill);
+			vg_batch_count = 0;
+			vg_edge_count = 1;
+			continue;
+		}
+
+		pending = &vg_batch_items[vg_batch_pending++];
+		pending->item   = i;
+		pending->bounds = vg_grid_bounds;
+		pending->first  = first;
+		pending->count  = vg_batch_take(first);
+		pending->edges  = vg_edge_count - edges;
+	}
+
+	vg_batch_draw(items, &flat);
+	vg_batch_active = 0;
+}
+
+vgFill vg_stream_fill;
+
+// While streaming, points are binned as they are produced instead of being
+// stored in vg_path_buffer. Only path commands may be issued until the end,
+// fills and strokes assert.
+
+static void vg_fill_stream(float x, float y, int start)
+{
+	if (start) {
+		vg_fill_winding = vg.state.winding >= 0 ? 1 : -1;
+		vg_fill_moveto(x, y);
+	} else {
+		vg_fill_lineto(x, y);
+	}
+}
+
+// The paint is given up front, a linear gradient as vg_fillg takes it or a flat
+// color when both colors are equal.
+
+void vg_fill_begin_stream(unsigned c0, unsigned c1, float x0, float y0, float x1, float y1)
+{
+	vgMatrix matrix;
+	matrix = vg.state.matrix;
+	if (c0 == c1) {
+		vg_fill_set(&vg_stream_fill, vg.state.mode, VG_FILL_FLAT, c0, c0, 0, 0, 0, 0, &matrix);
+	} else {
+		vg_matrix_translate(matrix.v, x0, y0);
+		vg_fill_set(&vg_stream_fill, vg.state.mode, VG_FILL_LIN, c0, c1, x1 - x0, y1 - y0, 0, 0, &matrix);
+	}
+	vg_fill_begin();
+	vg_path_stream = 1;
+}
+
+void vg_fill_end_stream()
+{
+	vg_push_path();
+	vg_path_stream = 0;
+	vg_path_reset = 1;
+	vg_fill_close();
+	vg_fill_draw(&vg_stream_fill);
+}
+
+/*//////////////////////////
+// STROKE
+//////////////////////////*/
+
+// Strokes are outlined in device space and binned as they are produced. Each
+// contour is walked forward and back, offset to the left of the walk, with
+// joins between segments and caps at the ends of open contours. Inner joins
+// meet at the offset lines' intersection when it lies within both segments.
+
+#define VG_STROKE_TOL  (0.25f)  // device pixels for round joins and caps
+#define VG_STROKE_FLAT (1e-3f)  // sine under which a join is straight
+
+vgMatrix vg_stroke_mt;
+vgMatrix vg_stroke_mi;
+float    vg_stroke_radius;
+
+static vgPoint vg_stroke_offset(vgPoint p0, vgPoint p1)
+{
+	vgPoint n0, n1;
+	float l;
+	n0.x = p1.y - p0.y;
+	n0.y = p0.x - p1.x;
+	n1.x = n0.x * vg_stroke_mi.xx + n0.y * vg_stroke_mi.xy;
+	n1.y = n0.x * vg_stroke_mi.yx + n0.y * vg_stroke_mi.yy;
+	vg_point_norm(&n1, &l);
+	n0.x = (n1.x * vg_stroke_mt.xx + n1.y * vg_stroke_mt.xy) * vg_stroke_radius;
+	n0.y = (n1.x * vg_stroke_mt.yx + n1.y * vg_stroke_mt.yy) * vg_stroke_radius;
+	return n0;
+}
+
+static void vg_stroke_arc(vgPoint p, vgPoint a, float angle)
+{
+	float r, da, c, s, t;
+	int i, n;
+	r = sqrtf(a.x * a.x + a.y * a.y);
+	da = r > VG_STROKE_TOL ? 2.0f * acosf(1.0f - VG_STROKE_TOL / r) : VG_PI / 2;
+	n = (int)ceilf(fabsf(angle) / da);
+	n = n < 1 ? 1 : n;
+	for (i = 0; i <= n; i++) {
+		t = angle * i / n;
+		c = cosf(t);
+		s = sinf(t);
+		vg_fill_lineto(p.x + a.x * c - a.y * s, p.y + a.x * s + a.y * c);
+	}
+}
+
+static void vg_stroke_join(vgPoint p, vgPoint d0, vgPoint n0, vgPoint d1, vgPoint n1)
+{
+	float cross, dot, t, s, l;
+	vgPoint m;
+
+	cross = d0.x * d1.y - d0.y * d1.x;
+	dot   = d0.x * d1.x + d0.y * d1.y;
+	l     = sqrtf((d0.x * d0.x + d0.y * d0.y) * (d1.x * d1.x + d1.y * d1.y));
+
+	if (dot > 0 && fabsf(cross) <= VG_STROKE_FLAT * l) {
+		vg_fill_lineto(p.x + (n0.x + n1.x) / 2, p.y + (n0.y + n1.y) / 2);
+		return;
+	}
+
+	if (cross != 0) {
+		t = ((n1.x - n0.x) * d1.y - (n1.y - n0.y) * d1.x) / cross;
+		s = ((n1.x - n0.x) * d0.y - (n1.y - n0.y) * d0.x) / cross;
+		m.x = p.x + n0.x + d0.x * t;
+		m.y = p.y + n0.y + d0.y * t;
+	} else {
+		t = s = 0;
+		m = p;
+	}
+
+	// inner side, turning towards the offset
+	if (d1.x * n0.x + d1.y * n0.y > 0) {
+		if (cross != 0 && t >= -0.5f && s <= 0.5f) {
+			vg_fill_lineto(m.x, m.y);
+		} else {
+			vg_fill_lineto(p.x + n0.x, p.y + n0.y);
+			vg_fill_lineto(p.x + n1.x, p.y + n1.y);
+		}
+		return;
+	}
+
+	switch (vg.state.join) {
+	case VG_JOIN_ROUND:
+		vg_stroke_arc(p, n0, atan2f(n0.x * n1.y - n0.y * n1.x, n0.x * n1.x + n0.y * n1.y));
+		return;
+	case VG_JOIN_MITER:
+		l = vg.state.miter * vg.state.miter * (n0.x * n0.x + n0.y * n0.y);
+		if (cross != 0 && (m.x - p.x) * (m.x - p.x) + (m.y - p.y) * (m.y - p.y) <= l) {
+			vg_fill_lineto(m.x, m.y);
+			return;
+		}
+		// fall through - past the limit the join is bevelled
+	default:
+		vg_fill_lineto(p.x + n0.x, p.y + n0.y);
+		vg_fill_lineto(p.x + n1.x, p.y + n1.y);
+		return;
+	}
+}
+
+// Leads from the end of one side to the start of the other, p + n to p - n
+
+static void vg_stroke_cap(vgPoint p, vgPoint d, vgPoint n)
+{
+	vgPoint e;
+	e.x = -n.y;
+	e.y = n.x;
+	if (e.x * d.x + e.y * d.y < 0) {
+		e.x = -e.x;
+		e.y = -e.y;
+	}
+	switch (vg.state.cap) {
+	case VG_CAP_ROUND:
+		vg_stroke_arc(p, n, n.x * e.y - n.y * e.x > 0 ? VG_PI : -VG_PI);
+		break;
+	case VG_CAP_SQUARE:
+		vg_fill_lineto(p.x + n.x + e.x, p.y + n.y + e.y);
+		vg_fill_lineto(p.x - n.x + e.x, p.y - n.y + e.y);
+		break;
+	}
+}
+
+// Next point along the contour [first, last] that differs from j, or -1
+
+static int vg_stroke_next(int j, int step, int first, int last, int closed)
+{
+	vgPoint p, q;
+	int k;
+	p = vg_path_buffer[j].point;
+	for (k = j + step; ; k += step) {
+		if (k > last || k < first) {
+			if (!closed)
+				return -1;
+			k = k > last ? first : last;
+		}
+		if (k == j)
+			return -1;
+		q = vg_path_buffer[k].point;
+		if (q.x != p.x || q.y != p.y)
+			return k;
+	}
+}
+
+static void vg_stroke_side(int start, int step, int first, int last, int closed)
+{
+	vgPoint pa, pb, pc, d0, d1, n0, n1;
+	int a, b, c, n, reach, walked;
+
+	// a closed side ends once the walk passes a, the last distinct point
+	// before the start; the path may revisit the start's coordinates earlier
+	a = start;
+	n = last - first + 1;
+	reach = walked = 0;
+	if (closed) {
+		a = vg_stroke_next(start, -step, first, last, closed);
+		if (a < 0)
+			return;
+		b = start;
+		reach = (a - start) * step;
+		reach = reach > 0 ? reach : reach + n;
+	} else {
+		b = vg_stroke_next(a, step, first, last, closed);
+	}
+
+	pa = vg_path_buffer[a].point;
+	pb = vg_path_buffer[b].point;
+	d0.x = pb.x - pa.x;
+	d0.y = pb.y - pa.y;
+	n0 = vg_stroke_offset(pa, pb);
+	if (!closed)
+		vg_fill_lineto(pa.x + n0.x, pa.y + n0.y);
+
+	while ((c = vg_stroke_next(b, step, first, last, closed)) >= 0) {
+		pc = vg_path_buffer[c].point;
+		d1.x = pc.x - pb.x;
+		d1.y = pc.y - pb.y;
+		n1 = vg_stroke_offset(pb, pc);
+		vg_stroke_join(pb, d0, n0, d1, n1);
+		walked += (c - b) * step > 0 ? (c - b) * step : (c - b) * step + n;
+		b = c;
+		pb = pc;
+		d0 = d1;
+		n0 = n1;
+		if (closed && walked > reach)
+			break;
+	}
+
+	if (closed) {
+		vg_fill_close();
+	} else {
+		vg_fill_lineto(pb.x + n0.x, pb.y + n0.y);
+		vg_stroke_cap(pb, d0, n0);
+	}
+}
+
+static void vg_stroke_dot(vgPoint p)
+{
+	vgPoint n, d;
+	d.x = 1;
+	d.y = 0;
+	n = vg_stroke_offset(p, (vgPoint) { p.x + d.x, p.y + d.y });
+	if (vg.state.cap == VG_CAP_BUTT)
+		return;
+	vg_fill_lineto(p.x - n.x, p.y - n.y);
+	vg_stroke_cap(p, (vgPoint) { -d.x, -d.y }, (vgPoint) { -n.x, -n.y });
+	vg_fill_lineto(p.x + n.x, p.y + n.y);
+	vg_stroke_cap(p, d, n);
+	vg_fill_close();
+}
+
+// Hairlines bin each segment into every tile within reach of its band, clipped
+// to the tile's edge window. Joins and caps come out round. Dash pieces keep in
+// the low bits of their arc whether they start (1) or end (2) the path, ends
+// tells if the segment does.
+
+static void vg_hairline_segment(vgPoint a, vgPoint b, float reach, float arc, int ends)
+{
+	float ax, ay, bx, by, dx, dy, t0, t1, p[4], q[4], lo, hi, x0, x1, length;
+	int ix, iy, ix0, ix1, iy0, iy1, i, edge;
+	unsigned bits;
+
+	ax = (a.x + VG_TILE_DIMS) * VG_PIXEL_SIZE;
+	ay = a.y * VG_PIXEL_SIZE;
+	bx = (b.x + VG_TILE_DIMS) * VG_PIXEL_SIZE;
+	by = b.y * VG_PIXEL_SIZE;
+	dx = bx - ax;
+	dy = by - ay;
+	length = sqrtf(dx * dx + dy * dy) / VG_PIXEL_SIZE;
+	reach *= VG_PIXEL_SIZE;
+
+	iy0 = (int)floorf(((ay < by ? ay : by) - reach) / VG_TILE_SIZE);
+	iy1 = (int)floorf(((ay > by ? ay : by) + reach) / VG_TILE_SIZE);
+	iy0 = iy0 < 0 ? 0 : iy0;
+	iy1 = iy1 > vg_grid_sizey - 1 ? vg_grid_sizey - 1 : iy1;
+
+	for (iy = iy0; iy <= iy1; iy++) {
+		// x extent of the segment across the row and its reach
+		lo = (float)(iy * VG_TILE_SIZE) - reach;
+		hi = (float)((iy + 1) * VG_TILE_SIZE) + reach;
+		t0 = 0;
+		t1 = 1;
+		if (dy != 0) {
+			t0 = ((dy > 0 ? lo : hi) - ay) / dy;
+			t1 = ((dy > 0 ? hi : lo) - ay) / dy;
+			t0 = t0 < 0 ? 0 : t0;
+			t1 = t1 > 1 ? 1 : t1;
+		}
+		if (t0 > t1)
+			continue;
+		x0 = ax + dx * t0;
+		x1 = ax + dx * t1;
+		ix0 = (int)floorf(((x0 < x1 ? x0 : x1) - reach) / VG_TILE_SIZE);
+		ix1 = (int)floorf(((x0 > x1 ? x0 : x1) + reach) / VG_TILE_SIZE);
+		ix0 = ix0 < 0 ? 0 : ix0;
+		ix1 = ix1 > vg_grid_sizex - 1 ? vg_grid_sizex - 1 : ix1;
+
+		for (ix = ix0; ix <= ix1; ix++) {
+			p[0] = -dx; q[0] = ax - (float)(ix * VG_TILE_SIZE - VG_EDGE_BORDER);
+			p[1] =  dx; q[1] = (float)(ix * VG_TILE_SIZE + VG_TILE_SIZE + VG_EDGE_BORDER - 1) - ax;
+			p[2] = -dy; q[2] = ay - (float)(iy * VG_TILE_SIZE - VG_EDGE_BORDER);
+			p[3] =  dy; q[3] = (float)(iy * VG_TILE_SIZE + VG_TILE_SIZE + VG_EDGE_BORDER - 1) - ay;
+			t0 = 0;
+			t1 = 1;
+			for (i = 0; i < 4; i++) {
+				if (p[i] == 0) {
+					if (q[i] < 0)
+						t1 = -1;
+				} else if (p[i] < 0) {
+					t0 = q[i] / p[i] > t0 ? q[i] / p[i] : t0;
+				} else {
+					t1 = q[i] / p[i] < t1 ? q[i] / p[i] : t1;
+				}
+			}
+			if (t0 <= t1) {
+				edge = vg_edge_count;
+				vg_push_edge(ix, iy,
+					(int)(ax + dx * t0), (int)(ay + dy * t0),
+					(int)(ax + dx * t1), (int)(ay + dy * t1));
+				if (vg_fill_lines == VG_DASH && vg_edge_count > edge) {
+					vg_edge_arcs[edge] = fmodf(arc + length * t0, vg_dash_period);
+					bits  = *((unsigned*)&vg_edge_arcs[edge]) & ~3u;
+					bits |= (ends & 1) && t0 == 0 ? 1 : 0;
+					bits |= (ends & 2) && t1 == 1 ? 2 : 0;
+					*((unsigned*)&vg_edge_arcs[edge]) = bits;
+				}
+			}
+		}
+	}
+
+	vg_push_bounds(a.x + VG_TILE_DIMS - reach / VG_PIXEL_SIZE, a.y - reach / VG_PIXEL_SIZE);
+	vg_push_bounds(a.x + VG_TILE_DIMS + reach / VG_PIXEL_SIZE, a.y + reach / VG_PIXEL_SIZE);
+	vg_push_bounds(b.x + VG_TILE_DIMS - reach / VG_PIXEL_SIZE, b.y - reach / VG_PIXEL_SIZE);
+	vg_push_bounds(b.x + VG_TILE_DIMS + reach / VG_PIXEL_SIZE, b.y + reach / VG_PIXEL_SIZE);
+}
+
+static void vg_hairline(unsigned color, float width)
+{
+	vgPath path;
+	vgFill fill;
+	int i, j;
+
+	vg_fill_begin();
+	vg_fill_winding = 1;
+	vg_fill_lines = VG_HAIRLINE;
+
+	for (i = 0; i < vg_path_count; i = path.end) {
+		path = vg_path_buffer[i++];
+		for (j = i + 1; j < path.end; j++)
+			vg_hairline_segment(vg_path_buffer[j - 1].point, vg_path_buffer[j].point, width * 0.5f + 0.5f, 0, 0);
+	}
+
+	vg_fill_set(&fill, VG_HAIRLINE, VG_FILL_FLAT, color, color, 0, 0, 0, 0, &vg.state.matrix);
+	fill.rsv1 = (char)(unsigned char)(width * 64.0f + 0.5f);
+	vg_fill_draw(&fill);
+	vg_fill_lines = 0;
+}
+
+// Dashes are lines that carry their arc length, the shader masks them by the
+// pattern, so the edges do not depend on how often the pattern repeats. Joins
+// come out round, the ends of dashes and of the path take the cap.
+
+static void vg_dash(unsigned color, float width, const float *ends, int pairs, float phase)
+{
+	vgPath path;
+	vgFill fill;
+	vgPoint a, b;
+	float arc;
+	int i, j;
+
+	vg_fill_begin();
+	vg_fill_winding = 1;
+	vg_fill_lines  = VG_DASH;
+	vg_dash_period = ends[VG_DASH_MAX - 1];
+
+	for (i = 0; i < vg_path_count; i = path.end) {
+		path = vg_path_buffer[i++];
+		arc  = phase;
+		for (j = i + 1; j < path.end; j++) {
+			a = vg_path_buffer[j - 1].point;
+			b = vg_path_buffer[j].point;
+			vg_hairline_segment(a, b, width * 0.5f + 0.5f, arc, (j == i + 1) | (j == path.end - 1) << 1);
+			arc = fmodf(arc + sqrtf((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)), vg_dash_period);
+		}
+	}
+
+	vg_fill_set(&fill, VG_DASH, VG_FILL_FLAT, color, color, width, 0, 0, 0, &vg.state.matrix);
+	memcpy(fill.matrix, ends, sizeof(fill.matrix));
+	fill.rsv1 = (char)(vg.state.cap | pairs << 2);
+	vg_fill_draw(&fill);
+	vg_fill_lines = 0;
+}
+
+// Patterns longer than a dash fill holds and strokes too wide for lines are
+// cut into dash subpaths, appended after the path and stroked as polygons.
+
+static void vg_dash_push(int *head, vgPoint a, vgPoint b, float t, int winding)
+{
+	if (vg_path_count >= VG_MAX_PATH - 2)
+		return;
+	if (*head < 0) {
+		*head = vg_path_count++;
+		vg_path_buffer[*head].closed  = 0;
+		vg_path_buffer[*head].winding = winding;
+	}
+	vg_path_buffer[vg_path_count++].point = (vgPoint) { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+}
+
+static void vg_dash_split(const float *pattern, int n, int count, float scale, float phase)
+{
+	vgPath path;
+	vgPoint a, b;
+	float length, left, skip, step, t;
+	int i, j, k, end, head;
+
+	end = vg_path_count;
+	for (i = 0; i < end; i = path.end) {
+		path = vg_path_buffer[i++];
+
+		k    = 0;
+		skip = phase;
+		left = pattern[0] * scale;
+		while (skip > left) {
+			skip -= left;
+			k = (k + 1) % count;
+			left = pattern[k % n] * scale;
+		}
+		left -= skip;
+		head  = -1;
+
+		for (j = i + 1; j < path.end; j++) {
+			a = vg_path_buffer[j - 1].point;
+			b = vg_path_buffer[j].point;
+			length = sqrtf((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+			if (length == 0)
+				continue;
+
+			for (t = 0;;) {
+				step = left < length - t ? left : length - t;
+				if ((k & 1) == 0) {
+					if (head < 0)
+						vg_dash_push(&head, a, b, t / length, path.winding);
+					vg_dash_push(&head, a, b, (t + step) / length, path.winding);
+				}
+				t    += step;
+				left -= step;
+				if (left > 0)
+					break;
+				if (head >= 0)
+					vg_path_buffer[head].end = vg_path_count;
+				head = -1;
+				k = (k + 1) % count;
+				left = pattern[k % n] * scale;
+			}
+		}
+
+		if (head >= 0)
+			vg_path_buffer[head].end = vg_path_count;
+	}
+	vg_path_index = vg_path_count;
+}
+
+static void vg_stroke_paths(unsigned color, float width, int begin, int end)
+{
+	vgPath path;
+	vgFill fill;
+	int i, first, last;
+
+	vg_fill_begin();
+
+	vg_stroke_radius = width / 2.0f;
+	vg_matrix_inverse(vg_stroke_mi.v, vg_stroke_mt.v);
+
+	for (i = begin; i < end; i = path.end) {
+		path = vg_path_buffer[i++];
+		first = i;
+		last = path.closed && path.end - 1 > first ? path.end - 2 : path.end - 1;
+		vg_fill_winding = path.winding ? 1 : -1;
+		if (vg_stroke_next(first, 1, first, last, path.closed) < 0) {
+			vg_stroke_dot(vg_path_buffer[first].point);
+		} else if (path.closed) {
+			vg_stroke_side(first, 1, first, last, 1);
+			vg_stroke_side(first, -1, first, last, 1);
+		} else {
+			vg_stroke_side(first, 1, first, last, 0);
+			vg_stroke_side(last, -1, first, last, 0);
+			vg_fill_close();
+		}
+	}
+
+	vg_fill_set(&fill, VG_NONZERO, VG_FILL_FLAT, color, color, 0, 0, 0, 0, &vg_stroke_mt);
+	vg_fill_draw(&fill);
+}
+
+void vg_stroke(unsigned color, float width)
+{
+	float scale;
+
+	vg_stroke_mt = vg.state.matrix;
+	scale = sqrtf(fabsf(vg_stroke_mt.xx * vg_stroke_mt.yy - vg_stroke_mt.xy * vg_stroke_mt.yx));
+	if (VG_HAIRLINES && width * scale <= VGL_HAIRLINE_WIDTH) {
+		vg_hairline(color, width * scale);
+		return;
+	}
+
+	vg_stroke_paths(color, width, 0, vg_path_count);
+}
+
+// The pattern alternates dash and gap lengths in user units starting with a
+// dash, an odd count is repeated. offset shifts the pattern along each subpath.
+
+void vg_stroke_dash(unsigned color, float width, const float *pattern, int n, float offset)
+{
+	float ends[VG_DASH_MAX], period, scale;
+	int i, count, end;
+
+	vg_stroke_mt = vg.state.matrix;
+	scale = sqrtf(fabsf(vg_stroke_mt.xx * vg_stroke_mt.yy - vg_stroke_mt.xy * vg_stroke_mt.yx));
+
+	count  = n & 1 ? n * 2 : n;
+	period = 0;
+	for (i = 0; i < count; i++) {
+		if (pattern[i % n] < 0)
+			break;
+		period += pattern[i % n] * scale;
+	}
+	if (n <= 0 || i < count || !(period > 0)) {
+		vg_stroke(color, width);
+		return;
+	}
+
+	offset = fmodf(offset * scale, period);
+	offset = offset < 0 ? offset + period : offset;
+
+	if (VG_HAIRLINES && count <= VG_DASH_MAX && width * scale * 0.5f + 0.5f <= VG_LINE_REACH) {
+		for (i = 0; i < VG_DASH_MAX; i++)
+			ends[i] = i < count ? (i > 0 ? ends[i - 1] : 0) + pattern[i % n] * scale : period;
+		vg_dash(color, width * scale, ends, count / 2, offset);
+		return;
+	}
+
+	vg_push_path();
+	end = vg_path_count;
+	vg_dash_split(pattern, n, count, scale, offset);
+	vg_stroke_paths(color, width, end, vg_path_count);
+	vg_path_count = end;
+	vg_path_index = end;
+}
+
+/*//////////////////////////
+// SHAPE
+//////////////////////////*/
+
+// Retained shapes keep their contours in user space along with Douglas-Peucker
+// simplifications at power-of-two tolerances. The level drawn is picked from the
+// scale of the current matrix, so vertex and edge counts stay roughly constant when
+// zooming out. Contours smaller than a level's tolerance are dropped from it.
+
+#define VG_LOD_LEVELS    (20)
+#define VG_LOD_BASE      (1.0f / 65536.0f) // finest tolerance relative to extent
+#define VG_LOD_TOLERANCE (0.25f)           // device pixels
+
+typedef struct vgShapeLevel {
+	float    tolerance;
+	int      npoints;
+	int      ncontours;
+	vgPoint *points;
+	int     *counts;
+} vgShapeLevel;
+
+struct vgShape {
+	vgPoint      min;
+	vgPoint      max;
+	int          nlevels;
+	vgShapeLevel levels[VG_LOD_LEVELS];
+};
+
+static float vg_shape_dist2(vgPoint p, vgPoint a, vgPoint b)
+{
+	float dx, dy, px, py, l, t;
+	dx = b.x - a.x;
+	dy = b.y - a.y;
+	px = p.x - a.x;
+	py = p.y - a.y;
+	l = dx * dx + dy * dy;
+	if (l > 0) {
+		t = (px * dx + py * dy) / l;
+		t = t < 0 ? 0 : t > 1 ? 1 : t;
+		px -= dx * t;
+		py -= dy * t;
+	}
+	return px * px + py * py;
+}
+
+static int vg_shape_simplify(vgPoint *dst, const vgPoint *src, int n, float tol, char *keep, int *stack)
+{
+	int a, b, i, imax, top, count;
+	float d, dmax, tol2;
+
+	if (n <= 2) {
+		memcpy(dst, src, n * sizeof(vgPoint));
+		return n;
+	}
+
+	tol2 = tol * tol;
+	memset(keep, 0, n);
+	keep[0] = keep[n - 1] = 1;
+
+	top = 0;
+	stack[top++] = 0;
+	stack[top++] = n - 1;
+
+	while (top > 0) {
+		b = stack[--top];
+		a = stack[--top];
+		dmax = 0;
+		imax = -1;
+		for (i = a + 1; i < b; i++) {
+			d = vg_shape_dist2(src[i], src[a], src[b]);
+			if (d > dmax) {
+				dmax = d;
+				imax = i;
+			}
+		}
+		if (imax >= 0 && dmax > tol2) {
+			keep[imax] = 1;
+			stack[top++] = a;
+			stack[top++] = imax;
+			stack[top++] = imax;
+			stack[top++] = b;
+		}
+	}
+
+	for (i = 0, count = 0; i < n; i++) {
+		if (keep[i]) dst[count++] = src[i];
+	}
+	return count;
+}
+
+static void vg_shape_reduce(vgShapeLevel *dst, vgShapeLevel *src, float tol, char *keep, int *stack)
+{
+	vgPoint *p, min, max;
+	int i, j, n;
+
+	dst->tolerance = tol;
+	dst->npoints   = 0;
+	dst->ncontours = 0;
+	dst->points    = malloc((src->npoints + 1) * sizeof(vgPoint));
+	dst->counts    = malloc((src->ncontours + 1) * sizeof(int));
+
+	for (i = 0, p = src->points; i < src->ncontours; i++, p += n) {
+		n = src->counts[i];
+		if (n < 2)
+			continue;
+		min = max = p[0];
+		for (j = 1; j < n; j++) {
+			min.x = p[j].x < min.x ? p[j].x : min.x;
+			min.y = p[j].y < min.y ? p[j].y : min.y;
+			max.x = p[j].x > max.x ? p[j].x : max.x;
+			max.y = p[j].y > max.y ? p[j].y : max.y;
+		}
+		if (max.x - min.x < tol && max.y - min.y < tol)
+			continue;
+		dst->counts[dst->ncontours++] = vg_shape_simplify(&dst->points[dst->npoints], p, n, tol, keep, stack);
+		dst->npoints += dst->counts[dst->ncontours - 1];
+	}
+}
+
+vgShape* vg_shape_create(const vgPoint *points, const int *counts, int ncontours)
+{
+	vgShapeLevel *level;
+	vgShape *shape;
+	int i, n, nmax, *stack;
+	float tol, extent;
+	char *keep;
+
+	shape = calloc(1, sizeof(vgShape));
+	level = &shape->levels[0];
+
+	for (i = 0, n = 0, nmax = 0; i < ncontours; i++) {
+		n += counts[i];
+		nmax = counts[i] > nmax ? counts[i] : nmax;
+	}
+
+	level->tolerance = 0;
+	level->npoints   = n;
+	level->ncontours = ncontours;
+	level->points    = malloc((n + 1) * sizeof(vgPoint));
+	level->counts    = malloc((ncontours + 1) * sizeof(int));
+	memcpy(level->points, points, n * sizeof(vgPoint));
+	memcpy(level->counts, counts, ncontours * sizeof(int));
+	shape->nlevels = 1;
+
+	if (n == 0) return shape;
+
+	shape->min = shape->max = points[0];
+	for (i = 1; i < n; i++) {
+		shape->min.x = points[i].x < shape->min.x ? points[i].x : shape->min.x;
+		shape->min.y = points[i].y < shape->min.y ? points[i].y : shape->min.y;
+		shape->max.x = points[i].x > shape->max.x ? points[i].x : shape->max.x;
+		shape->max.y = points[i].y > shape->max.y ? points[i].y : shape->max.y;
+	}
+
+	extent = shape->max.x - shape->min.x;
+	extent = shape->max.y - shape->min.y > extent ? shape->max.y - shape->min.y : extent;
+	if (extent <= 0) return shape;
+
+	keep  = malloc(nmax);
+	stack = malloc(nmax * 2 * sizeof(int));
+
+	for (tol = extent * VG_LOD_BASE; shape->nlevels < VG_LOD_LEVELS; tol *= 2.0f) {
+		level = &shape->levels[shape->nlevels++];
+		vg_shape_reduce(level, level - 1, tol, keep, stack);
+		if (level->npoints == 0) break;
+	}
+
+	free(keep);
+	free(stack);
+	return shape;
+}
+
+void vg_shape_free(vgShape *shape)
+{
+	int i;
+	if (!shape) return;
+	for (i = 0; i < shape->nlevels; i++) {
+		free(shape->levels[i].points);
+		free(shape->levels[i].counts);
+	}
+	free(shape);
+}
+
+static vgShapeLevel* vg_shape_level(vgShape *shape)
+{
+	vgMatrix m; float sx, sy, tol; int i;
+
+	// largest device length of a unit vector in user space
+	m = vg.state.matrix;
+	sx = m.xx * m.xx + m.yx * m.yx;
+	sy = m.xy * m.xy + m.yy * m.yy;
+	sx = sqrtf(sx > sy ? sx : sy);
+
+	i = shape->nlevels - 1;
+	if (sx > 0) {
+		tol = VG_LOD_TOLERANCE / sx;
+		while (i > 0 && shape->levels[i].tolerance > tol) i--;
+	}
+	return &shape->levels[i];
+}
+
+void vg_shape_draw(vgShape *shape)
+{
+	vgShapeLevel *level;
+	vgPoint *p;
+	int i, j, n;
+
+	level = vg_shape_level(shape);
+
+	for (i = 0, p = level->points; i < level->ncontours; i++, p += n) {
+		n = level->counts[i];
+		if (n < 2)
+			continue;
+		vg_moveto(p[0].x, p[0].y);
+		for (j = 1; j < n; j++) {
+			vg_lineto(p[j].x, p[j].y);
+		}
+	}
+}
+
+/*//////////////////////////
+// SCENE
+//////////////////////////*/
+
+// An optional retained layer over shapes. Items keep their paint parameters in
+// user space and are indexed by a bounding-volume hierarchy that is rebuilt lazily
+// after edits. Drawing walks the hierarchy with the viewport (and clip) mapped back
+// through the current matrix and submits only the intersecting items, in the order
+// they were added.
+
+#define VG_BVH_LEAF (4)
+
+typedef struct vgSceneItem {
+	vgShape *shape;
+	float    minx, miny;
+	float    maxx, maxy;
+	float    width;
+	float    miter;
+	int      join;
+	int      cap;
+	int      mode;
+	int      type;
+	unsigned color0;
+	unsigned color1;
+	float    extent[2];
+	float    radius[2];
+	float    paint[4];
+} vgSceneItem;
+
+typedef struct vgSceneNode {
+	float minx, miny;
+	float maxx, maxy;
+	int   first; // leaf: first index in order, node: left child (right is first + 1)
+	int   count; // leaf: number of items, node: 0
+} vgSceneNode;
+
+struct vgScene {
+	vgSceneItem *items;
+	vgSceneNode *nodes;
+	int         *order;
+	int         *visible;
+	int          nitems;
+	int          nnodes;
+	int          capacity;
+	int          dirty;
+};
+
+static vgScene *vg_scene_sort;
+static int      vg_scene_axis;
+
+vgScene* vg_scene_create()
+{
+	return calloc(1, sizeof(vgScene));
+}
+
+void vg_scene_free(vgScene *scene)
+{
+	if (!scene) return;
+	free(scene->items);
+	free(scene->nodes);
+	free(scene->order);
+	free(scene->visible);
+	free(scene);
+}
+
+static vgSceneItem* vg_scene_add(vgScene *scene, vgShape *shape, int type, unsigned c0, unsigned c1, float width)
+{
+	vgSceneItem *item;
+	float r;
+
+	if (scene->nitems == scene->capacity) {
+		scene->capacity = scene->capacity ? scene->capacity * 2 : 256;
+		scene->items    = realloc(scene->items, scene->capacity * sizeof(vgSceneItem));
+	}
+
+	// a miter tip reaches miter half widths past the joint and a square
+	// cap corner sqrt(2) of them, the item strokes with the state captured here
+	r = 1.0f;
+	if (vg.state.join == VG_JOIN_MITER && vg.state.miter > r)
+		r = vg.state.miter;
+	if (vg.state.cap == VG_CAP_SQUARE && VG_SQRT2 > r)
+		r = VG_SQRT2;
+	r *= width * 0.5f;
+	item = &scene->items[scene->nitems++];
+	memset(item, 0, sizeof(vgSceneItem));
+	item->shape    = shape;
+	item->minx     = shape->min.x - r;
+	item->miny     = shape->min.y - r;
+	item->maxx     = shape->max.x + r;
+	item->maxy     = shape->max.y + r;
+	item->width    = width;
+	item->miter    = vg.state.miter;
+	item->join     = vg.state.join;
+	item->cap      = vg.state.cap;
+	item->mode     = vg.state.mode;
+	item->type     = type;
+	item->color0   = c0;
+	item->color1   = c1;
+	item->paint[2] = 1.0f;
+	item->paint[3] = 1.0f;
+	scene->dirty   = 1;
+	return item;
+}
+
+void vg_scene_fill(vgScene *scene, vgShape *shape, unsigned color)
+{
+	vg_scene_add(scene, shape, VG_FILL_FLAT, color, color, 0);
+}
+
+void vg_scene_fillr(vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x, float y, float r0, float r1)
+{
+	vgSceneItem *item;
+	item = vg_scene_add(scene, shape, VG_FILL_RAD, c0, c1, 0);
+	item->paint[0]  = x;
+	item->paint[1]  = y;
+	item->radius[0] = r0;
+	item->radius[1] = r1;
+}
+
+void vg_scene_fillb(vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x, float y, float w, float h, float r0, float r1)
+{
+	vgSceneItem *item;
+	item = vg_scene_add(scene, shape, VG_FILL_BOX, c0, c1, 0);
+	item->paint[0]  = x + w / 2;
+	item->paint[1]  = y + h / 2;
+	item->extent[0] = w / 2;
+	item->extent[1] = h / 2;
+	item->radius[0] = r0;
+	item->radius[1] = r1;
+}
+
+void vg_scene_fillg(vgScene *scene, vgShape *shape, unsigned c0, unsigned c1, float x0, float y0, float x1, float y1)
+{
+	vgSceneItem *item;
+	item = vg_scene_add(scene, shape, VG_FILL_LIN, c0, c1, 0);
+	item->paint[0]  = x0;
+	item->paint[1]  = y0;
+	item->extent[0] = x1 - x0;
+	item->extent[1] = y1 - y0;
+}
+
+void vg_scene_stroke(vgScene *scene, vgShape *shape, unsigned color, float width)
+{
+	vg_scene_add(scene, shape, VG_FILL_FLAT, color, color, width);
+}
+
+static int vg_scene_compare(const void *a, const void *b)
+{
+	vgSceneItem *ia, *ib;
+	float ca, cb;
+	ia = &vg_scene_sort->items[*(const int*)a];
+	ib = &vg_scene_sort->items[*(const int*)b];
+	ca = vg_scene_axis ? ia->miny + ia->maxy : ia->minx + ia->maxx;
+	cb = vg_scene_axis ? ib->miny + ib->maxy : ib->minx + ib->maxx;
+	return ca < cb ? -1 : ca > cb ? 1 : 0;
+}
+
+static int vg_scene_compare_index(const void *a, const void *b)
+{
+	return *(const int*)a - *(const int*)b;
+}
+
+static void vg_scene_split(vgScene *scene, int inode, int first, int count)
+{
+	vgSceneNode *node;
+	vgSceneItem *item;
+	int i, half, left;
+
+	node = &scene->nodes[inode];
+	item = &scene->items[scene->order[first]];
+	node->minx = item->minx;
+	node->miny = item->miny;
+	node->maxx = item->maxx;
+	node->maxy = item->maxy;
+
+	for (i = first + 1; i < first + count; i++) {
+		item = &scene->items[scene->order[i]];
+		node->minx = item->minx < node->minx ? item->minx : node->minx;
+		node->miny = item->miny < node->miny ? item->miny : node->miny;
+		node->maxx = item->maxx > node->maxx ? item->maxx : node->maxx;
+		node->maxy = item->maxy > node->maxy ? item->maxy : node->maxy;
+	}
+
+	if (count <= VG_BVH_LEAF) {
+		node->first = first;
+		node->count = count;
+		return;
+	}
+
+	// median split along the longest axis
+	vg_scene_sort = scene;
+	vg_scene_axis = (node->maxy - node->miny) > (node->maxx - node->minx);
+	qsort(&scene->order[first], count, sizeof(int), vg_scene_compare);
+
+	half = count / 2;
+	left = scene->nnodes;
+	scene->nnodes += 2;
+	node->first = left;
+	node->count = 0;
+
+	vg_scene_split(scene, left + 0, first, half);
+	vg_scene_split(scene, left + 1, first + half, count - half);
+}
+
+static void vg_scene_build(vgScene *scene)
+{
+	int i;
+
+	free(scene->nodes);
+	free(scene->order);
+	free(scene->visible);
+
+	scene->nodes   = malloc((scene->nitems * 2 + 1) * sizeof(vgSceneNode));
+	scene->order   = malloc((scene->nitems + 1) * sizeof(int));
+	scene->visible = malloc((scene->nitems + 1) * sizeof(int));
+	scene->nnodes  = 1;
+	scene->dirty   = 0;
+
+	for (i = 0; i < scene->nitems; i++)
+		scene->order[i] = i;
+
+	if (scene->nitems > 0)
+		vg_scene_split(scene, 0, 0, scene->nitems);
+}
+
+static void vg_scene_draw_item(vgSceneItem *item)
+{
+	vgMatrix matrix;
+	vgFill fill;
+	float miter;
+	int join, cap;
+
+	vg_shape_draw(item->shape);
+
+	if (item->width > 0) {
+		miter = vg.state.miter;
+		join  = vg.state.join;
+		cap   = vg.state.cap;
+		vg.state.miter = item->miter;
+		vg.state.join  = item->join;
+		vg.state.cap   = item->cap;
+		vg_stroke(item->color0, item->width);
+		vg.state.miter = miter;
+		vg.state.join  = join;
+		vg.state.cap   = cap;
+		return;
+	}
+
+	matrix = vg.state.matrix;
+	vg_matrix_translate(matrix.v, item->paint[0], item->paint[1]);
+	vg_matrix_scale(matrix.v, item->paint[2], item->paint[3]);
+	vg_fill_set(&fill, item->mode, item->type, item->color0, item->color1,
+		item->extent[0], item->extent[1], item->radius[0], item->radius[1], &matrix);
+	vg_fill_base(&fill);
+}
+
+static void vg_scene_view(float *view)
+{
+	vgMatrix m; float x, y, w, h; int i;
+	float cx[4], cy[4];
+
+	w = (float)vg.size.x;
+	h = (float)vg.size.y;
+
+	// device bounds of the clip rectangle, noclip maps every pixel to 0.5
+	if (vg.state.clip.xx != 0 || vg.state.clip.xy != 0 ||
+		vg.state.clip.yx != 0 || vg.state.clip.yy != 0) {
+		vg_matrix_inverse(m.v, vg.state.clip.v);
+		view[0] = view[1] = 1e30f;
+		view[2] = view[3] = -1e30f;
+		for (i = 0; i < 4; i++) {
+			x = (float)(i & 1);
+			y = (float)(i >> 1);
+			vg_matrix_project(m.v, &x, &y);
+			view[0] = x < view[0] ? x : view[0];
+			view[1] = y < view[1] ? y : view[1];
+			view[2] = x > view[2] ? x : view[2];
+			view[3] = y > view[3] ? y : view[3];
+		}
+		view[0] = view[0] > 0 ? view[0] : 0;
+		view[1] = view[1] > 0 ? view[1] : 0;
+		view[2] = view[2] < w ? view[2] : w;
+		view[3] = view[3] < h ? view[3] : h;
+	} else {
+		view[0] = 0;
+		view[1] = 0;
+		view[2] = w;
+		view[3] = h;
+	}
+
+	cx[0] = view[0]; cy[0] = view[1];
+	cx[1] = view[2]; cy[1] = view[1];
+	cx[2] = view[0]; cy[2] = view[3];
+	cx[3] = view[2]; cy[3] = view[3];
+
+	view[0] = view[1] = 1e30f;
+	view[2] = view[3] = -1e30f;
+	for (i = 0; i < 4; i++) {
+		vg_unproject(&cx[i], &cy[i]);
+		view[0] = cx[i] < view[0] ? cx[i] : view[0];
+		view[1] = cy[i] < view[1] ? cy[i] : view[1];
+		view[2] = cx[i] > view[2] ? cx[i] : view[2];
+		view[3] = cy[i] > view[3] ? cy[i] : view[3];
+	}
+}
+
+void vg_scene_draw(vgScene *scene)
+{
+	vgSceneNode *node;
+	int stack[64], top, nvisible, i;
+	float view[4];
+
+	if (scene->dirty)
+		vg_scene_build(scene);
+
+	if (scene->nitems == 0)
+		return;
+
+	vg_scene_view(view);
+
+	nvisible = 0;
+	top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		node = &scene->nodes[stack[--top]];
+		if (node->maxx < view[0] || node->minx > view[2] ||
+			node->maxy < view[1] || node->miny > view[3])
+			continue;
+		if (node->count > 0) {
+			for (i = node->first; i < node->first + node->count; i++) {
+				vgSceneItem *item = &scene->items[scene->order[i]];
+				if (item->maxx < view[0] || item->minx > view[2] ||
+					item->maxy < view[1] || item->miny > view[3])
+					continue;
+				scene->visible[nvisible++] = scene->order[i];
+			}
+		} else {
+			stack[top++] = node->first + 1;
+			stack[top++] = node->first;
+		}
+	}
+
+	// restore paint order
+	qsort(scene->visible, nvisible, sizeof(int), vg_scene_compare_index);
+
+	vg.stats.visible += nvisible;
+	vg.stats.culled  += scene->nitems - nvisible;
+
+	for (i = 0; i < nvisible; i++)
+		vg_scene_draw_item(&scene->items[scene->visible[i]]);
+}
+
+/*//////////////////////////
+// IMAGE
+//////////////////////////*/
+
+// Images are packed into the pages of an atlas as power-of-two squares of a
+// buddy quadtree. They keep a copy of their pixels: resident images are kept in
+// LRU order and the least recently drawn are evicted when a block is missing.
+// The atlas is sampled clamped to the image edge, without mipmaps.
+
+#ifndef VG_IMAGE_PAGES
+#define VG_IMAGE_PAGES  (4)    // layers of the atlas
+#endif
+#define VG_IMAGE_PAGE   (1024) // side of a page
+#define VG_IMAGE_LEVELS (6)    // block sides from the page down to 32
+#define VG_IMAGE_NODES  (1365) // quadtree nodes of a page, (4^levels - 1) / 3
+
+#define VG_NODE_FREE    (0)
+#define VG_NODE_SPLIT   (1)
+#define VG_NODE_USED    (2)
+
+struct vgImage {
+	unsigned *pixels;
+	int       w, h;
+	int       page;   // -1 while not resident
+	int       node;
+	int       stamp;  // flush it was last drawn in
+	vgImage  *prev;   // resident images, most recently drawn first
+	vgImage  *next;
+};
+
+unsigned char vg_image_nodes[VG_IMAGE_PAGES][VG_IMAGE_NODES];
+vgImage      *vg_image_head;
+vgImage      *vg_image_tail;
+
+vgImage* vg_image_create(const unsigned *pixels, int w, int h)
+{
+	vgImage *image;
+	if (w <= 0 || h <= 0 || w > VG_IMAGE_PAGE || h > VG_IMAGE_PAGE)
+		return NULL;
+	image = calloc(1, sizeof(vgImage));
+	image->pixels = malloc(w * h * sizeof(unsigned));
+	memcpy(image->pixels, pixels, w * h * sizeof(unsigned));
+	image->w    = w;
+	image->h    = h;
+	image->page = -1;
+	return image;
+}
+
+static int vg_image_find(int page, int node, int level, int target, int split)
+{
+	int state, child, found;
+
+	state = vg_image_nodes[page][node];
+	if (state == VG_NODE_USED || (state == VG_NODE_FREE && level < target && !split))
+		return -1;
+	if (level == target)
+		return state == VG_NODE_FREE ? node : -1;
+
+	for (child = node * 4 + 1; child <= node * 4 + 4; child++) {
+		found = vg_image_find(page, child, level + 1, target, split);
+		if (found >= 0) {
+			vg_image_nodes[page][node] = VG_NODE_SPLIT;
+			return found;
+		}
+	}
+	return -1;
+}
+
+static void vg_image_evict(vgImage *image)
+{
+	int page, node;
+
+	page = image->page;
+	node = image->node;
+	vg_image_nodes[page][node] = VG_NODE_FREE;
+	while (node > 0) {
+		node = (node - 1) / 4;
+		if (vg_image_nodes[page][node * 4 + 1] != VG_NODE_FREE ||
+			vg_image_nodes[page][node * 4 + 2] != VG_NODE_FREE ||
+			vg_image_nodes[page][node * 4 + 3] != VG_NODE_FREE ||
+			vg_image_nodes[page][node * 4 + 4] != VG_NODE_FREE)
+			break;
+		vg_image_nodes[page][node] = VG_NODE_FREE;
+	}
+
+	*(image->prev ? &image->prev->next : &vg_image_head) = image->next;
+	*(image->next ? &image->next->prev : &vg_image_tail) = image->prev;
+	image->page = -1;
+}
+
+static void vg_image_touch(vgImage *image)
+{
+	if (image->page >= 0) {
+		*(image->prev ? &image->prev->next : &vg_image_head) = image->next;
+		*(image->next ? &image->next->prev : &vg_image_tail) = image->prev;
+	}
+	image->prev = NULL;
+	image->next = vg_image_head;
+	*(vg_image_head ? &vg_image_head->prev : &vg_image_tail) = image;
+	vg_image_head = image;
+	image->stamp = vg_flush_stamp;
+}
+
+// Compacts the even bits of a Morton index, blocks of a level lie in Z order
+
+static int vg_morton(int i)
+{
+	i &= 0x5555;
+	i = (i | (i >> 1)) & 0x3333;
+	i = (i | (i >> 2)) & 0x0F0F;
+	i = (i | (i >> 4)) & 0x00FF;
+	return i;
+}
+
+static void vg_image_place(vgImage *image)
+{
+	int level, size, page, node, index, split;
+
+	if (image->page >= 0) {
+		vg_image_touch(image);
+		return;
+	}
+
+	level = VG_IMAGE_LEVELS - 1;
+	size  = VG_IMAGE_PAGE >> level;
+	while (size < image->w || size < image->h) {
+		level--;
+		size <<= 1;
+	}
+
+	// blocks of images drawn since the last flush are only reused after it
+	for (node = -1; node < 0;) {
+		for (split = 0; split < 2 && node < 0; split++)
+			for (page = 0; page < VG_IMAGE_PAGES && node < 0; page++)
+				node = vg_image_find(page, 0, 0, level, split);
+		if (node < 0) {
+			if (vg_image_tail->stamp == vg_flush_stamp)
+				vg_flush();
+			vg_image_evict(vg_image_tail);
+		}
+	}
+
+	page -= 1;
+	vg_image_nodes[page][node] = VG_NODE_USED;
+	vg_image_touch(image);
+	image->page = page;
+	image->node = node;
+
+	index = node - ((1 << (level * 2)) - 1) / 3;
+	vg_driver_image(page, vg_morton(index) * size, vg_morton(index >> 1) * size, image->w, image->h, image->pixels);
+	vg.stats.upload += image->w * image->h * sizeof(unsigned);
+}
+
+void vg_image_free(vgImage *image)
+{
+	if (!image)
+		return;
+	if (image->page >= 0) {
+		if (image->stamp == vg_flush_stamp)
+			vg_flush();
+		vg_image_evict(image);
+	}
+	free(image->pixels);
+	free(image);
+}
+
+// The matrix maps image pixels to user space, NULL places the image at the
+// origin. The fill samples the image through the inverse of that placement.
+
+void vg_filli(vgImage *image, const float *matrix)
+{
+	vgMatrix m, s;
+	const float *i;
+	vgFill fill;
+	int index, size, level;
+
+	assert(!vg_path_stream);
+	if (!image)
+		return;
+	vg_image_place(image);
+
+	s = vg.state.matrix;
+	if (matrix) {
+		i = matrix;
+		m.xx = s.xx * i[0] + s.xy * i[3];
+		m.xy = s.xx * i[1] + s.xy * i[4];
+		m.xt = s.xx * i[2] + s.xy * i[5] + s.xt;
+		m.yx = s.yx * i[0] + s.yy * i[3];
+		m.yy = s.yx * i[1] + s.yy * i[4];
+		m.yt = s.yx * i[2] + s.yy * i[5] + s.yt;
+	} else {
+		m = s;
+	}
+
+	for (level = 0, size = VG_IMAGE_PAGE; ((1 << ((level + 1) * 2)) - 1) / 3 <= image->node; level++)
+		size >>= 1;
+	index = image->node - ((1 << (level * 2)) - 1) / 3;
+
+	vg_fill_set(&fill, vg.state.mode, VG_FILL_IMAGE, 0xFFFFFFFF, 0xFFFFFFFF,
+		(float)(vg_morton(index) * size), (float)(vg_morton(index >> 1) * size),
+		(float)image->w, (float)image->h, &m);
+	fill.rsv1 = (char)image->page;
+	vg_fill_base(&fill);
+
+	// the fill may have flushed, its last tiles are in the current batch
+	image->stamp = vg_flush_stamp;
+}
+
+/*//////////////////////////
+// DRIVER
+//////////////////////////*/
+
+#ifndef VGL_LOG
+#define VGL_LOG(msg) printf("%s: %d: %s\n", __FILE__, __LINE__, msg)
+#endif
+
+#define VGL_SHADER_(...) #__VA_ARGS__
+#define VGL_SHADER(...)  VGL_SHADER_(__VA_ARGS__)
+
+/*//////////////////////////
+// DRIVER: OPENGL
+//////////////////////////*/
+
+#if VGL_DRIVER == VGL_OPENGL
+
+#undef min
+#undef max
+
+#define VGL_VERSION "#version 330\n"
+#define VGL_VERSION_COMPUTE "#version 430\n"
+
+#define VGL_TRACE() do {\
+	GLenum err;\
+	while ((err = glGetError()) != GL_NO_ERROR) {\
+		GLchar errmsg[64];\
+		sprintf(errmsg, "opengl: error: %i %s [%i]", err, __FILE__, __LINE__);\
+		VGL_LOG(errmsg);\
+	}} while(0)
+
+// Variants specialize the shaders through these macros, constant arguments let the
+// compiler drop the fill type and subpixel branches a program never takes.
+
+const GLchar* vgl_shader_variant[VG_VARIANT_COUNT] = {
+	"#define VG_VARIANT_FILL(f) " VGL_SHADER(VG_FILL_FLAT) "\n#define VG_VARIANT_SPAA(s) 0.0\n",
+	"#define VG_VARIANT_FILL(f) f\n#define VG_VARIANT_SPAA(s) 0.0\n",
+	"#define VG_VARIANT_FILL(f) " VGL_SHADER(VG_FILL_FLAT) "\n#define VG_VARIANT_SPAA(s) s\n",
+	"#define VG_VARIANT_FILL(f) f\n#define VG_VARIANT_SPAA(s) s\n",
+};
+
+const GLchar* vgl_shader_lib =
+VGL_SHADER(
+	precision highp float;
+	precision highp int;
+
+	uniform usamplerBuffer udata;
+	uniform sampler2D     uramps;
+	uniform sampler2DArray uimages;
+	uniform ivec2 uscreensize;
+	uniform int   usegment;
+
+	int du8(const uint v) {
+		return int(v);
+	}
+
+	int du16(const uvec2 v) {
+		return int(v.r + (v.g << 8));
+	}
+
+	int du24(const uvec3 v) {
+		return int(v.r + (v.g << 8) + (v.b << 16));
+	}
+
+	uint du32(const uvec4 v) {
+		return v.r + (v.g << 8) + (v.b << 16) + (v.a << 24);
+	}
+
+	int di8(const uint v) {
+		int r = int(v); return r > 127 ? r - 256 : r;
+	}
+
+	int di16(const uvec2 v) {
+		int r = int(du16(v)); return r > 32767 ? r - 65536 : r;
+	}
+
+	int di24(const uvec3 v) {
+		int r = int(du24(v)); return r > 8388607 ? r - 16777216 : r;
+	}
+
+	int di32(const uvec4 v) {
+		return int(du32(v));
+	}
+
+	float df8(const uint v) {
+		return float(v) / 255.0;
+	}
+
+	float df32(const uvec4 v) {
+		return uintBitsToFloat(v.r + (v.g << 8) + (v.b << 16) + (v.a << 24));
+	}
+
+	vec4 dv4(const uvec4 v) {
+		return vec4(v) / 255.0;
+	}
+
+	uvec4 get_value(const int index) {
+		return texelFetch(udata, index);
+	}
+
+	int    hmode;
+	int    hfill;
+	float  hspaa;
+	float  hwidth;
+	int    hdashes;
+	mat2x3 hdash;
+	int    hatlas;
+	vec4   hcolor0;
+	vec4   hcolor1;
+	mat2x3 hclip;
+	mat2x3 hgrad;
+	vec2   hextent;
+	vec2   hradius;
+
+	void load_fill(const int data) {
+		uvec4 args = get_value(data);
+
+		int block;
+
+		hmode   = di8(args.r);
+		hfill   = di8(args.g);
+		hspaa   = df8(args.b);
+		hwidth  = float(args.a) / 64.0;
+		hcolor0 = dv4(get_value(data + 1));
+		hcolor1 = hcolor0;
+
+		block = di32(get_value(data + 2));
+		if (block >= 0) {
+			hclip[0].x = df32(get_value(block + 0));
+			hclip[0].y = df32(get_value(block + 1));
+			hclip[0].z = df32(get_value(block + 2));
+			hclip[1].x = df32(get_value(block + 3));
+			hclip[1].y = df32(get_value(block + 4));
+			hclip[1].z = df32(get_value(block + 5));
+		} else {
+			hclip = mat2x3(0.0, 0.0, 0.5, 0.0, 0.0, 0.5);
+		}
+
+		if (hmode == VG_DASH) {
+			block = di32(get_value(data + 3));
+			hdash[0].x = df32(get_value(block + 0));
+			hdash[0].y = df32(get_value(block + 1));
+			hdash[0].z = df32(get_value(block + 2));
+			hdash[1].x = df32(get_value(block + 3));
+			hdash[1].y = df32(get_value(block + 4));
+			hdash[1].z = df32(get_value(block + 5));
+			hwidth  = df32(get_value(data + 4));
+			hdashes = int(args.a);
+		}
+
+		if (hfill != VG_FILL_FLAT) {
+			hatlas  = int(args.a);
+			hcolor1 = dv4(get_value(data + 3));
+			block = di32(get_value(data + 4));
+			hgrad[0].x = df32(get_value(block + 0));
+			hgrad[0].y = df32(get_value(block + 1));
+			hgrad[0].z = df32(get_value(block + 2));
+			hgrad[1].x = df32(get_value(block + 3));
+			hgrad[1].y = df32(get_value(block + 4));
+			hgrad[1].z = df32(get_value(block + 5));
+			hextent.x  = df32(get_value(data + 5));
+			hextent.y  = df32(get_value(data + 6));
+			hradius.x  = df32(get_value(data + 7));
+			hradius.y  = df32(get_value(data + 8));
+		}
+	}
+
+	vec3 hsv2rgb(vec3 c) {
+		vec4 K = vec4(1.0, 2.0 / 3.0, 1.0 / 3.0, 3.0);
+		vec3 p = abs(fract(c.xxx + K.xyz) * 6.0 - K.www);
+		return c.z * mix(K.xxx, clamp(p - K.xxx, 0.0, 1.0), c.y);
+	}
+
+	vec3 rgb2hsv(vec3 c) {
+		vec4 K = vec4(0.0, -1.0 / 3.0, 2.0 / 3.0, -1.0);
+		vec4 p = mix(vec4(c.bg, K.wz), vec4(c.gb, K.xy), step(c.b, c.g));
+		vec4 q = mix(vec4(p.xyw, c.r), vec4(c.r, p.yzx), step(p.x, c.r));
+		float d = q.x - min(q.w, q.y);
+		float e = 1.0e-10;
+		return vec3(abs(q.z + (q.w - q.y) / (6.0 * d + e)), d / (q.x + e), q.x);
+	}
+);
+
+const GLchar* vgl_shader_tile =
+VGL_SHADER(
+	ivec2  tcoord;
+	int    tsign;
+	int    tcount;
+	int    tindex;
+	int    tdata;
+
+	void load_tile(const uint coord, const uint edges) {
+		uvec4 args; int entry;
+
+		tcoord = ivec2(coord & 0xFFFu, (coord >> 12) & 0xFFFu);
+		tsign  = int(coord) >> 24;
+		tcount = int(edges & 0xFFu);
+		entry  = usegment + int(edges >> 18) * 2;
+		tdata  = di32(get_value(entry));
+		tindex = di32(get_value(entry + 1)) + int((edges >> 8) & 0x3FFu);
+
+		// banded tiles carry a negative count
+		if (tcount == VG_TILE_ESCAPE) {
+			args   = get_value(tindex);
+			tsign  = di16(args.rg);
+			tcount = du16(args.ba);
+			tcount = tcount >= VG_TILE_BANDED ? VG_TILE_BANDED - tcount : tcount;
+			tindex = tindex - abs(tcount);
+		}
+	}
+);
+
+// GPU binned tiles point at a record after their edges: sign[0:16] count[16:32]
+// and the fill header.
+
+const GLchar* vgl_shader_bin_tile =
+VGL_SHADER(
+	ivec2  tcoord;
+	int    tsign;
+	int    tcount;
+	int    tindex;
+	int    tdata;
+
+	void load_tile(const uint coord, const uint edges) {
+		uvec4 args;
+
+		tcoord = ivec2(coord & 0xFFFu, (coord >> 12) & 0xFFFu);
+		args   = get_value(int(edges));
+		tsign  = di16(args.rg);
+		tcount = du16(args.ba);
+		tindex = int(edges) - tcount;
+		tdata  = di32(get_value(int(edges) + 1));
+	}
+);
+
+const GLchar* vgl_shader_vs =
+VGL_SHADER(
+	in uint icoord;
+	in uint iedges;
+
+	flat out int    vmode;
+	flat out int    vfill;
+	flat out float  vspaa;
+	flat out float  vwidth;
+	flat out int    vdashes;
+	flat out mat2x3 vdash;
+	flat out int    vatlas;
+	flat out int    vsign;
+	flat out int    vcount;
+	flat out int    vindex;
+	flat out ivec2  vcoord;
+	flat out vec4   vcolor0;
+	flat out vec4   vcolor1;
+	flat out vec2   vextent;
+	flat out vec2   vradius;
+	flat out vec2   vscale;
+	flat out mat2x3 vclipm;
+	flat out mat2x3 vgradm;
+
+	out vec2 vpixel;
+	out vec2 vscreen;
+
+	void main() {
+		// quads are 4 vertex strips, flat outputs are taken from the last vertex
+		// of each triangle so the first two skip the tile and fill fetches
+		vcoord  = ivec2(icoord & 0xFFFu, (icoord >> 12) & 0xFFFu);
+		vpixel  = vec2(gl_VertexID & 1, gl_VertexID >> 1) * VG_TILE_DIMS;
+		vscreen = vec2(vcoord * VG_TILE_DIMS + vpixel);
+
+		if (gl_VertexID >= 2) {
+			load_tile(icoord, iedges);
+			load_fill(tdata);
+
+			vmode   = hmode;
+			vfill   = hfill;
+			vspaa   = hspaa;
+			vwidth  = hwidth;
+			vdashes = hdashes;
+			vdash   = hdash;
+			vcolor0 = hcolor0;
+			vcolor1 = hcolor1;
+			vsign   = tsign;
+			vcount  = tcount;
+			vindex  = tindex;
+			vclipm  = hclip;
+
+			if (vfill != VG_FILL_FLAT) {
+				vatlas  = hatlas;
+				vgradm  = hgrad;
+				vscale  = abs(hgrad[0].xy) + abs(hgrad[1].xy);
+				vextent = hextent;
+				vradius = hradius;
+			} else {
+				vgradm = mat2x3(0.0);
+				vscale = vec2(1.0);
+			}
+		}
+
+		gl_Position = vec4((vscreen / uscreensize * 2.0 - 1.0) * vec2(1.0, -1.0), 0.0, 1.0);
+	}
+);
+
+const GLchar* vgl_shader_fs_in =
+VGL_SHADER(
+	flat in int    vmode;
+	flat in int    vfill;
+	flat in float  vspaa;
+	flat in float  vwidth;
+	flat in int    vdashes;
+	flat in mat2x3 vdash;
+	flat in int    vatlas;
+	flat in int    vsign;
+	flat in int    vcount;
+	flat in int    vindex;
+	flat in ivec2  vcoord;
+	flat in vec4   vcolor0;
+	flat in vec4   vcolor1;
+	flat in vec2   vextent;
+	flat in vec2   vradius;
+	flat in vec2   vscale;
+	flat in mat2x3 vclipm;
+	flat in mat2x3 vgradm;
+
+	in vec2 vpixel;
+	in vec2 vscreen;
+
+	vec2 vclip;
+	vec2 vgrad;
+
+	layout(location = 0, index = 0) out vec4 fcolor;
+	layout(location = 0, index = 1) out vec4 fmask;
+
+	uvec4 get_edge(const int index) {
+		return get_value(index);
+	}
+);
+
+const GLchar* vgl_shader_fs =
+VGL_SHADER(
+	vec2 pixel;
+
+	float eval_area(vec2 a, vec2 b, in vec2 l, in vec2 window) {
+		float ta, tb, ty, th;
+		float area = 0.0;
+
+		/* right */
+		if (sign(a.x - window.y) != sign(b.x - window.y)) {
+			if (a.x < b.x) {
+				b.y = b.y - (b.x - window.y) * l.y;
+				b.x = window.y;
+			} else {
+				a.y = a.y - (a.x - window.y) * l.y;
+				a.x = window.y;
+			}
+		} else if (a.x > window.y) {
+			return 0.0;
+		}
+
+		/* left intersection */
+		if (sign(a.x - window.x) != sign(b.x - window.x)) {
+			// split edge into a rectangle and a trapezoid
+			// append rectangle area here and update
+			// coordinates to form the remaining trapezoid
+			if (a.x < b.x) {
+				ty = a.y - (a.x - window.x) * l.y;
+				th = ty - a.y;
+				a.y = ty;
+				a.x = window.x;
+			} else {
+				ty = b.y - (b.x - window.x) * l.y;
+				th = b.y - ty;
+				b.y = ty;
+				b.x = window.x;
+			}
+			/* signed area of rectangle (unit x) */
+			area -= th;
+		}
+
+		/* signed area of trapezoid */
+		th = clamp(b.y - a.y, -1.0, 1.0);
+		ta = clamp(window.y - a.x, 0.0, (window.y - window.x)) / (window.y - window.x);
+		tb = clamp(window.y - b.x, 0.0, (window.y - window.x)) / (window.y - window.x);
+		area -= (ta + tb) * 0.5 * th;
+
+		return area;
+	}
+
+	vec3 eval_span(vec2 a, vec2 b, const vec2 l) {
+		bool down = b.y > a.y;
+
+		/* top  */
+		if (sign(a.y) != sign(b.y)) {
+			if (down) {
+				a.x = a.x - a.y * l.x;
+				a.y = 0.0f;
+			} else {
+				b.x = b.x - b.y * l.x;
+				b.y = 0.0f;
+			}
+		} else if (a.y < 0) {
+			return vec3(0.0);
+		}
+
+		/* bottom  */
+		if (sign(a.y - 1) != sign(b.y - 1)) {
+			if (down) {
+				b.x = b.x - (b.y - 1) * l.x;
+				b.y = 1.0f;
+			} else {
+				a.x = a.x - (a.y - 1) * l.x;
+				a.y = 1.0f;
+			}
+		} else if (a.y > 1) {
+			return vec3(0.0);
+		}
+
+		if (VG_VARIANT_SPAA(vspaa) > 0.0) {
+			return vec3(
+				eval_area(a, b, l, vec2(      0.0, 1.0 / 3.0)),
+				eval_area(a, b, l, vec2(1.0 / 3.0, 2.0 / 3.0)),
+				eval_area(a, b, l, vec2(2.0 / 3.0,       1.0)));
+		}
+		return vec3(eval_area(a, b, l, vec2(0.0, 1.0)));
+	}
+
+	vec3 eval_edge(const vec2 a, const vec2 b) {
+		vec2 d = b - a;
+		return eval_span(a, b, vec2(d.x / d.y, d.y / d.x));
+	}
+
+	float eval_width(const float r) {
+		/* box filtered band of the line width at distance r from the pixel center */
+		return clamp(0.5 + vwidth * 0.5 - r, 0.0, 1.0) - clamp(0.5 - vwidth * 0.5 - r, 0.0, 1.0);
+	}
+
+	float eval_line(const vec2 a, const vec2 b) {
+		vec2  p = vec2(0.5) - a;
+		vec2  d = b - a;
+		return eval_width(length(p - d * clamp(dot(p, d) / dot(d, d), 0.0, 1.0)));
+	}
+
+	float eval_dash(const vec2 a, const vec2 b, const float s, const uint ends) {
+		/* dashes span [0, e0], [e1, e2], [e3, e4] of the period e5 and repeat a period
+		   either side, g is the distance along the line to the nearest, o their
+		   box filtered overlap with the pixel. Lines are not clamped at the ends of
+		   the path, the dashes are clipped to them and take the cap there */
+		vec2  p = vec2(0.5) - a;
+		vec2  d = b - a;
+		float l = length(d);
+		float t = dot(p, d) / (l * l);
+		float c = clamp(t, (ends & 1u) != 0u ? t : 0.0, (ends & 2u) != 0u ? t : 1.0);
+		float e = abs(t - c) * l;
+		float h = abs(p.x * d.y - p.y * d.x) / l;
+		float period = vdash[1].z;
+		float u = mod(s + c * l, period);
+		float lo = (ends & 1u) != 0u ? u - c * l : -2.0 * period;
+		float hi = (ends & 2u) != 0u ? u + (1.0 - c) * l : 3.0 * period;
+		float x = (vdashes & 3) == VG_CAP_SQUARE ? vwidth * 0.5 : 0.0;
+		float g = 1e6;
+		float o = 0.0;
+		vec2  r;
+		int   i, k;
+
+		for (k = -1; k <= 1; k++) {
+			for (i = 0; i < (vdashes >> 2); i++) {
+				r = (i == 0 ? vec2(0.0, vdash[0].x) : i == 1 ? vdash[0].yz : vdash[1].xy) + float(k) * period;
+				r = vec2(max(r.x, lo), min(r.y, hi));
+				if (r.x > r.y)
+					continue;
+				g = min(g, max(r.x - u, u - r.y));
+				o += max(min(r.y + x, u + 0.5) - max(r.x - x, u - 0.5), 0.0);
+			}
+		}
+
+		if ((vdashes & 3) == VG_CAP_ROUND)
+			return eval_width(length(vec2(h, e + max(g, 0.0))));
+		return eval_width(length(vec2(h, e))) * min(o, 1.0);
+	}
+
+	vec3 eval_step(const vec3 area, const vec2 a, const vec2 b) {
+		if (vmode == VG_HAIRLINE)
+			return max(area, vec3(eval_line(a, b)));
+		return area + eval_edge(a, b);
+	}
+
+	vec2 eval_point(uvec2 v) {
+		vec2 p = vec2(v) / 255.0;
+		p *= float(VG_EDGE_MASK);
+		p -= float(VG_EDGE_BORDER);
+		p /= float(VG_PIXEL_SIZE);
+		return p - pixel;
+	}
+
+	vec3 eval_edges();
+
+	vec3 eval_cover() {
+		vec3 area = eval_edges();
+		if (VG_VARIANT_SPAA(vspaa) > 0.0 && vspaa < 1.0) {
+			area = mix(vec3(dot(area, vec3(1.0 / 3.0))), area, vspaa);
+		}
+		return area;
+	}
+
+	vec3 eval_alpha() {
+		vec3 c, a;
+		c = eval_cover();
+		switch (vmode) {
+		case VG_NEGATIVE:
+			a = clamp(-c, 0.0, 1.0);
+			break;
+		case VG_POSITIVE:
+			a = clamp(c, 0.0, 1.0);
+			break;
+		case VG_NONZERO:
+			a = abs(clamp(c, -1.0, 1.0));
+			break;
+		case VG_EVENODD:
+			a = abs(mod(c + 1.0, 2.0) - 1.0);
+			break;
+		case VG_INTERSECTION:
+			a = clamp(abs(c) - 1.0, 0.0, 1.0);
+			break;
+		default:
+			a = clamp(c, 0.0, 1.0);
+			break;
+		}
+		return a;
+	}
+
+	float eval_dither(float seed) {
+		vec3 p = fract(vec3(vscreen.xyx) * vec3(443.8975, 397.2973, 491.1871));
+		p += dot(p, p.yzx + 19.19 + seed);
+		return (fract((p.x + p.y) * p.z) - 0.5) * (1.0 / 128.0);
+	}
+
+	vec4 eval_ramp(const float a) {
+		vec2 t;
+		if (vatlas == 0)
+			return mix(vcolor0, vcolor1, a);
+		// texel centers span the ramp, color0 carries the alpha
+		t = vec2(a * float(VG_RAMP_SIZE - 1) + 0.5, float(vatlas) - 0.5);
+		return textureLod(uramps, t / vec2(VG_RAMP_SIZE, VG_MAX_RAMPS), 0.0) * vcolor0;
+	}
+
+	/* coverage of a row of the rounded box blurred across x, in closed form
+	   with the erf approximation of Abramowitz and Stegun 7.1.27 */
+	float eval_shadow_row(float x, float y, float r, float s) {
+		float d = min(vextent.y - r - abs(y), 0.0);
+		float c = vextent.x - r + sqrt(max(r * r - d * d, 0.0));
+		vec2  e = (vec2(x) + vec2(-c, c)) * (0.70710678 / s);
+		vec2  a = abs(e);
+		vec2  q = 1.0 + (0.278393 + (0.230389 + (0.000972 + 0.078108 * a) * a) * a) * a;
+		q *= q;
+		e = sign(e) - sign(e) / (q * q);
+		return 0.5 * (e.y - e.x);
+	}
+
+	/* rows are weighted by the Gaussian across y, sampled within 3 deviations */
+	float eval_shadow() {
+		float s  = max(vradius.y, 0.5 * max(vscale.x, vscale.y));
+		float y0 = clamp(-3.0 * s, vgrad.y - vextent.y, vgrad.y + vextent.y);
+		float y1 = clamp( 3.0 * s, vgrad.y - vextent.y, vgrad.y + vextent.y);
+		float h  = (y1 - y0) * 0.25;
+		float a  = 0.0;
+		float y;
+		int   i;
+
+		for (i = 0; i < 4; i++) {
+			y = y0 + h * (float(i) + 0.5);
+			a += eval_shadow_row(vgrad.x, vgrad.y - y, vradius.x, s) * exp(-0.5 * y * y / (s * s));
+		}
+		return a * h / (s * 2.50662827);
+	}
+
+	vec4 eval_color() {
+		float d, a, r, w, b; vec2 v;
+		switch (VG_VARIANT_FILL(vfill)) {
+		case VG_FILL_LIN:
+			d = sqrt(dot(vgrad, vextent));
+			a = clamp(d / length(vextent), 0.0, 1.0);
+			return eval_ramp(a);
+		case VG_FILL_RAD:
+			d = length(vgrad) - vradius.x;
+			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
+			return eval_ramp(a);
+		case VG_FILL_RAD_HUE:
+			d = length(vgrad) - vradius.x;
+			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
+			v = normalize(vgrad);
+			r = acos(v.x) * sign(v.y) / VG_PI2 + 0.5;
+			return vec4(hsv2rgb(vec3(r, vextent.x * a, vextent.y * (1.0 - a) + a)), 1.0) * vcolor0;
+		case VG_FILL_RAD_SAT:
+			d = length(vgrad) - vradius.x;
+			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
+			r = length(vgrad / (vradius.y - vradius.x) / 2.0 + 0.5);
+			return vec4(hsv2rgb(vec3(vextent.x, r, a)), 1.0) * vcolor0;
+		case VG_FILL_BOX:
+			r = abs(vradius.y - vradius.x);
+			v = abs(vgrad) - (vextent - r);
+			d = length(max(v, 0.0)) + min(max(v.x, v.y), 0.0) - vradius.x - r;
+			a = clamp(d / (vradius.y - vradius.x), 0.0, 1.0);
+			return eval_ramp(a);
+		case VG_FILL_BOX_HUE:
+			v = clamp(vgrad, 0.0, 1.0);
+			return vec4(hsv2rgb(vec3(v.x, vextent.x, vextent.y)), 1.0) * vcolor0;
+		case VG_FILL_BOX_SAT:
+			v = clamp(vgrad, 0.0, 1.0);
+			return vec4(hsv2rgb(vec3(vextent.x, v.x, v.y)), 1.0) * vcolor0;
+		case VG_FILL_GRID:
+			v = abs(fract(vgrad / vextent) - 0.5) - (0.5 - vradius.x / vextent);
+			w = dot(vscale / vextent, vec2(0.5));
+			d = max(v.x, v.y);
+			a = smoothstep(w, -w, d);
+			return mix(vcolor0, vcolor1, a);
+		case VG_FILL_IMAGE:
+			v = clamp(vgrad, vec2(0.5), vradius - 0.5) + vextent;
+			return textureLod(uimages, vec3(v / float(VG_IMAGE_PAGE), float(vatlas)), 0.0) * vcolor0;
+		case VG_FILL_SHADOW:
+			return vec4(vcolor0.rgb, vcolor0.a * eval_shadow());
+		default:
+			a = 0.0;
+			return vcolor0;
+		}
+	}
+);
+
+// Strip edges, see vg_fill_strips
+
+const GLchar* vgl_shader_cover =
+VGL_SHADER(
+	int eval_band(const int band) {
+		uvec4 value;
+		if (band == VG_TILE_BANDS)
+			return -vcount;
+		value = get_edge(vindex + band / 2);
+		return (band & 1) == 0 ? du16(value.xy) : du16(value.zw);
+	}
+
+	vec3 eval_edges() {
+		uvec4 value; uvec2 last;
+		vec2 a, b;
+		int idx, end, band;
+		bool strip;
+		vec3 area;
+
+		idx =  vindex;
+		end  = vindex + vcount;
+		area = vec3(vsign);
+
+		// dash segments are followed by their arc length
+		if (vmode == VG_DASH) {
+			for (; idx < end; idx += 2) {
+				value = get_edge(idx);
+				a = eval_point(value.xy);
+				b = eval_point(value.zw);
+				value = get_edge(idx + 1);
+				area = max(area, vec3(eval_dash(a, b, df32(value), value.r & 3u)));
+			}
+			return area;
+		}
+
+		// banded tiles walk only the edges overlapping the pixel's rows
+		if (vcount < 0) {
+			band = int(pixel.y) * VG_TILE_BANDS / VG_TILE_DIMS;
+			idx  = vindex + eval_band(band);
+			end  = vindex + eval_band(band + 1);
+		}
+
+		// two strip points per texel, a repeated point restarts the strip
+		strip = false;
+		last  = uvec2(0u);
+		a     = vec2(0.0);
+
+		while (idx < end) {
+			value = get_edge(idx++);
+
+			if (strip && value.xy == last) {
+				strip = false;
+			} else {
+				b = eval_point(value.xy);
+				if (strip) area = eval_step(area, a, b);
+				strip = true;
+				a = b;
+			}
+
+			if (strip && value.zw == value.xy) {
+				strip = false;
+			} else {
+				b = eval_point(value.zw);
+				if (strip) area = eval_step(area, a, b);
+				strip = true;
+				a = b;
+			}
+
+			last = value.zw;
+		}
+
+		return area;
+	}
+);
+
+// Slope edges: three words per edge, its points and the reciprocal slopes
+// dx/dy, dy/dx. Edges are sorted by their top so a pixel row stops at the first
+// edge below it and skips the ones above without dividing.
+
+const GLchar* vgl_shader_slope_cover =
+VGL_SHADER(
+	vec3 eval_edges() {
+		uvec4 value;
+		vec2 a, b, l;
+		int idx, end;
+		vec3 area;
+
+		idx  = vindex;
+		end  = vindex + vcount;
+		area = vec3(vsign);
+
+		for (; idx < end; idx += 3) {
+			value = get_edge(idx);
+			a = eval_point(value.xy);
+			b = eval_point(value.zw);
+			if (min(a.y, b.y) >= 1.0)
+				break;
+			if (max(a.y, b.y) <= 0.0)
+				continue;
+			l = vec2(df32(get_edge(idx + 1)), df32(get_edge(idx + 2)));
+			area += eval_span(a, b, l);
+		}
+
+		return area;
+	}
+);
+
+const GLchar* vgl_shader_fs_main =
+VGL_SHADER(
+	float eval_clip() {
+		vec2  r = abs(vclip - 0.5) - vec2(0.5);
+		float d = length(max(r, 0.0)) + min(max(r.x, r.y), 0.0);
+		float w = fwidth(d);
+		return smoothstep(w, -w, d);
+	}
+
+	void main() {
+		vec4 color, alpha;
+		pixel  = floor(vpixel);
+		vclip  = (vec3(vscreen, 1.0) * vclipm).xy;
+		vgrad  = VG_VARIANT_FILL(vfill) != VG_FILL_FLAT ? (vec3(vscreen, 1.0) * vgradm).xy : vec2(0.0);
+		color  = eval_color();
+		alpha  = vec4(eval_alpha(), 1.0) * color.a * eval_clip();
+		fcolor = color * alpha;
+		fmask  = alpha;
+	}
+);
+
+// Tile lists: one instance per screen tile walks the ordered list of fills touching it,
+// front to back, compositing in registers so each pixel is blended once.
+
+const GLchar* vgl_shader_list_vs =
+VGL_SHADER(
+	in uint icoord;
+	in uint iedges;
+
+	flat out int ventries;
+	flat out int vlist;
+
+	out vec2 vpixel;
+	out vec2 vscreen;
+
+	void main() {
+		ivec2 coord;
+		coord    = ivec2(icoord & 0xFFFu, (icoord >> 12) & 0xFFFu);
+		vpixel   = vec2(gl_VertexID & 1, gl_VertexID >> 1) * VG_TILE_DIMS;
+		vscreen  = vec2(coord * VG_TILE_DIMS + vpixel);
+
+		if (gl_VertexID >= 2) {
+			ventries = di32(get_value(int(iedges)));
+			vlist    = int(iedges) + 1;
+		}
+
+		gl_Position = vec4((vscreen / uscreensize * 2.0 - 1.0) * vec2(1.0, -1.0), 0.0, 1.0);
+	}
+);
+
+const GLchar* vgl_shader_list_fs_in =
+VGL_SHADER(
+	flat in int ventries;
+	flat in int vlist;
+
+	in vec2 vpixel;
+	in vec2 vscreen;
+
+	int    vmode;
+	int    vfill;
+	float  vspaa;
+	float  vwidth;
+	int    vdashes;
+	mat2x3 vdash;
+	int    vatlas;
+	int    vsign;
+	int    vcount;
+	int    vindex;
+	vec4   vcolor0;
+	vec4   vcolor1;
+	vec2   vextent;
+	vec2   vradius;
+	vec2   vscale;
+	vec2   vclip;
+	vec2   vclipw;
+	vec2   vgrad;
+
+	layout(location = 0, index = 0) out vec4 fcolor;
+	layout(location = 0, index = 1) out vec4 fmask;
+
+	uvec4 get_edge(const int index) {
+		return get_value(index);
+	}
+);
+
+const GLchar* vgl_shader_list_entry =
+VGL_SHADER(
+	float eval_clip() {
+		// derivatives are undefined in the list loop, the clip is affine in screen space
+		vec2  r = abs(vclip - 0.5) - vec2(0.5);
+		float d = length(max(r, 0.0)) + min(max(r.x, r.y), 0.0);
+		float w = r.x > r.y ? vclipw.x : vclipw.y;
+		return smoothstep(w, -w, d);
+	}
+
+	void load_entry(const int entry) {
+		load_tile(du32(get_value(entry)), du32(get_value(entry + 1)));
+		load_fill(tdata);
+		vsign  = tsign;
+		vcount = tcount;
+		vindex = tindex;
+
+		vmode   = hmode;
+		vfill   = hfill;
+		vspaa   = hspaa;
+		vwidth  = hwidth;
+		vdashes = hdashes;
+		vdash   = hdash;
+		vcolor0 = hcolor0;
+		vcolor1 = hcolor1;
+		vclip   = (vec3(vscreen, 1.0) * hclip).xy;
+		vclipw  = vec2(abs(hclip[0].x) + abs(hclip[0].y), abs(hclip[1].x) + abs(hclip[1].y));
+
+		if (vfill != VG_FILL_FLAT) {
+			vatlas  = hatlas;
+			vgrad   = (vec3(vscreen, 1.0) * hgrad).xy;
+			vscale  = abs(hgrad[0].xy) + abs(hgrad[1].xy);
+			vextent = hextent;
+			vradius = hradius;
+		} else {
+			vgrad  = vec2(0.0);
+			vscale = vec2(1.0);
+		}
+	}
+);
+
+const GLchar* vgl_shader_list_fs_main =
+VGL_SHADER(
+	void main() {
+		vec4 color, alpha, accum, trans;
+		int entry;
+
+		pixel = floor(vpixel);
+		accum = vec4(0.0);
+		trans = vec4(1.0);
+
+		for (entry = vlist + (ventries - 1) * VG_LIST_WORDS; entry >= vlist; entry -= VG_LIST_WORDS) {
+			load_entry(entry);
+
+			color  = eval_color();
+			alpha  = vec4(eval_alpha(), 1.0) * color.a * eval_clip();
+			accum += trans * color * alpha;
+			trans *= 1.0 - alpha;
+
+			if (all(lessThan(trans, vec4(1.0 / 1024.0))))
+				break;
+		}
+
+		fcolor = accum;
+		fmask  = 1.0 - trans;
+	}
+);
+
+// Compute: one workgroup per screen tile walks the same lists, every fill's edge
+// strips are staged in shared memory once and read by all pixels of the tile, the
+// composite is blended into an image copied from and back to the framebuffer.
+
+const GLchar* vgl_shader_compute_in =
+VGL_SHADER(
+	layout(local_size_x = VG_COMPUTE_DIMS, local_size_y = VG_COMPUTE_DIMS) in;
+
+	layout(binding = 0, rgba8) uniform image2D uimage;
+	layout(std430, binding = 1) readonly buffer vgTiles { uvec2 itiles[]; };
+
+	uniform int ucount;
+
+	shared uint sedges[VG_COMPUTE_EDGES];
+
+	vec2   vpixel;
+	vec2   vscreen;
+
+	int    vmode;
+	int    vfill;
+	float  vspaa;
+	float  vwidth;
+	int    vdashes;
+	mat2x3 vdash;
+	int    vatlas;
+	int    vsign;
+	int    vcount;
+	int    vindex;
+	vec4   vcolor0;
+	vec4   vcolor1;
+	vec2   vextent;
+	vec2   vradius;
+	vec2   vscale;
+	vec2   vclip;
+	vec2   vclipw;
+	vec2   vgrad;
+
+	int    sbase;
+	int    scount;
+
+	uvec4 get_edge(const int index) {
+		// lists longer than the shared array read their tail from the buffer
+		uint v;
+		if (index - sbase >= scount)
+			return get_value(index);
+		v = sedges[index - sbase];
+		return uvec4(v & 0xFFu, (v >> 8) & 0xFFu, (v >> 16) & 0xFFu, v >> 24);
+	}
+);
+
+const GLchar* vgl_shader_compute_main =
+VGL_SHADER(
+	void main() {
+		vec4 color, alpha, accum, trans;
+		int id, list, entries, entry, index;
+		ivec2 coord, target;
+		uvec2 tile;
+
+		id = int(gl_WorkGroupID.x + gl_WorkGroupID.y * gl_NumWorkGroups.x);
+		if (id >= ucount)
+			return;
+
+		tile    = itiles[id];
+		coord   = ivec2(tile.x & 0xFFFu, (tile.x >> 12) & 0xFFFu);
+		vpixel  = vec2(gl_LocalInvocationID.xy) + 0.5;
+		vscreen = vec2(coord * VG_TILE_DIMS) + vpixel;
+		pixel   = floor(vpixel);
+		target  = ivec2(coord * VG_TILE_DIMS + ivec2(gl_LocalInvocationID.xy));
+		target.y = uscreensize.y - 1 - target.y;
+
+		list    = int(tile.y);
+		entries = di32(get_value(list));
+		list   += 1;
+		accum   = vec4(0.0);
+		trans   = vec4(1.0);
+
+		// the list is uniform across the group, every invocation takes the barriers
+		for (entry = list + (entries - 1) * VG_LIST_WORDS; entry >= list; entry -= VG_LIST_WORDS) {
+			load_entry(entry);
+
+			barrier();
+			sbase  = vindex;
+			scount = min(abs(vcount), VG_COMPUTE_EDGES);
+			for (index = int(gl_LocalInvocationIndex); index < scount; index += VG_COMPUTE_DIMS * VG_COMPUTE_DIMS)
+				sedges[index] = du32(get_value(sbase + index));
+			barrier();
+
+			color  = eval_color();
+			alpha  = vec4(eval_alpha(), 1.0) * color.a * eval_clip();
+			accum += trans * color * alpha;
+			trans *= 1.0 - alpha;
+		}
+
+		imageStore(uimage, target, accum + imageLoad(uimage, target) * trans);
+	}
+);
+
+// GPU binning: every pass is a dispatch of the same program. Points walk their
+// segment with the front-end's fixed-point stepping, first counting edges and
+// signs per cell, then or-ing edges as lone three point strips into the slots
+// the row pass assigned. Rows accumulate the sign left to right like vg_fill_draw
+// and a single group scans the row totals into tile and word offsets.
+
+const GLchar* vgl_shader_bin =
+VGL_SHADER(
+	layout(local_size_x = VG_BIN_GROUP) in;
+
+	layout(std430, binding = 0) buffer vgData    { uint  bdata[];    };
+	layout(std430, binding = 1) buffer vgTiles   { uvec2 btiles[];   };
+	layout(std430, binding = 2) buffer vgCells   { int   bcells[];   };
+	layout(std430, binding = 3) buffer vgRows    { ivec2 brows[];    };
+	layout(std430, binding = 4) buffer vgCommand { uint  bcommand[]; };
+
+	uniform ivec2 ugrid;
+	uniform int   ubins;
+	uniform int   uitems;
+	uniform int   ubase;
+	uniform int   upass;
+
+	shared ivec2 spartial[VG_BIN_GROUP];
+
+	int   bheader;
+	int   bcell;
+	int   bwinding;
+	ivec2 bmin;
+	ivec2 bsize;
+
+	int bin_find(const int item, const int field) {
+		// the last bin whose first point or row is at most item
+		int lo, hi, mid;
+		lo = 0;
+		hi = ubins - 1;
+		while (lo < hi) {
+			mid = (lo + hi + 1) / 2;
+			if (di32(get_value(usegment + mid * VG_BIN_WORDS + field)) <= item)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+		return usegment + lo * VG_BIN_WORDS;
+	}
+
+	void bin_load(const int bin) {
+		uint v;
+		bheader = di32(get_value(bin + 0));
+		bcell   = di32(get_value(bin + 3));
+		v = du32(get_value(bin + 5));
+		bmin  = ivec2(v & 0xFFFFu, v >> 16);
+		v = du32(get_value(bin + 6));
+		bsize = ivec2(v & 0xFFFFu, v >> 16);
+	}
+
+	int bin_cell(const int ix, const int iy) {
+		int x = ix - bmin.x, y = iy - bmin.y;
+		if (x < 0 || x >= bsize.x || y < 0 || y >= bsize.y)
+			return -1;
+		return (bcell + x + y * bsize.x) * 4;
+	}
+
+	void bin_edge(const int ix, const int iy, const int ax, const int ay, const int bx, const int by) {
+		uint a, b; int cell, slot, word;
+
+		if ((ax == bx && ay == by) ||
+			ix < 0 || ix >= ugrid.x ||
+			iy < 0 || iy >= ugrid.y)
+			return;
+
+		// the first column only carries sign, it gets no edge words
+		cell = bin_cell(ix, iy);
+		if (cell < 0 || ix == bmin.x)
+			return;
+
+		if (upass == VG_BIN_COUNT) {
+			atomicAdd(bcells[cell], 1);
+			return;
+		}
+
+		a = uint((ax - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER) & 0xFF) | uint((ay - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER) & 0xFF) << 8;
+		b = uint((bx - (ix << VG_TILE_LOG2) + VG_EDGE_BORDER) & 0xFF) | uint((by - (iy << VG_TILE_LOG2) + VG_EDGE_BORDER) & 0xFF) << 8;
+		if (bwinding < 0) {
+			slot = int(a);
+			a = b;
+			b = uint(slot);
+		}
+
+		// a b b, the repeated point ends the strip
+		slot = atomicAdd(bcells[cell + 3], 1) * 3;
+		word = bcells[cell + 2];
+		atomicOr(bdata[word + (slot + 0) / 2], a << (((slot + 0) & 1) * 16));
+		atomicOr(bdata[word + (slot + 1) / 2], b << (((slot + 1) & 1) * 16));
+		atomicOr(bdata[word + (slot + 2) / 2], b << (((slot + 2) & 1) * 16));
+	}
+
+	void bin_sign(int ix, const int iy, const int sign) {
+		int cell;
+
+		if (iy >= ugrid.y || iy < 0 ||
+			ix >= ugrid.x || upass != VG_BIN_COUNT)
+			return;
+
+		cell = bin_cell(ix < 0 ? 0 : ix, iy);
+		if (cell >= 0)
+			atomicAdd(bcells[cell + 1], -sign * bwinding);
+	}
+
+	void bin_sign_span(int iy0, int iy1) {
+		int iy;
+		iy0 = clamp(iy0, 0, ugrid.y - 1);
+		iy1 = clamp(iy1, 0, ugrid.y - 1);
+		for (iy = iy0; iy < iy1; iy++)
+			bin_sign(0, iy, +1);
+		for (iy = iy1; iy < iy0; iy++)
+			bin_sign(0, iy, -1);
+	}
+
+	void bin_segment(vec2 p, vec2 q) {
+		vec2 stack[VG_BIN_DEPTH];
+		int dx, dy, lx, ly, tx, ty;
+		int tx0, ty0, tx1, ty1;
+		int ix0, iy0, ix1, iy1;
+		int x0, y0, x1, y1;
+		int sx, sy, fx, fy;
+		int ex, ey, er;
+		int nx, ny, ni, top;
+
+		// halves of long segments are walked depth first, as the front-end recurses
+		top = 0;
+		stack[0] = q;
+
+		while (top >= 0) {
+			q  = stack[top];
+			x0 = int(p.x * float(VG_PIXEL_SIZE));
+			y0 = int(p.y * float(VG_PIXEL_SIZE));
+			x1 = int(q.x * float(VG_PIXEL_SIZE));
+			y1 = int(q.y * float(VG_PIXEL_SIZE));
+
+			if (x0 == x1 && y0 == y1) {
+				top--;
+				continue;
+			}
+
+			ix0 = x0 >> VG_TILE_LOG2;
+			iy0 = y0 >> VG_TILE_LOG2;
+			ix1 = x1 >> VG_TILE_LOG2;
+			iy1 = y1 >> VG_TILE_LOG2;
+
+			if ((iy0 < 0 && iy1 < 0) ||
+				(ix0 > ugrid.x && ix1 > ugrid.x) ||
+				(iy0 > ugrid.y && iy1 > ugrid.y)) {
+				p = q;
+				top--;
+				continue;
+			}
+
+			if (x0 < 0 && x1 < 0) {
+				bin_sign_span(iy0, iy1);
+				p = q;
+				top--;
+				continue;
+			}
+
+			dx = abs(x1 - x0);
+			dy = abs(y1 - y0);
+
+			if ((dx >= (64 << VG_TILE_LOG2) || dy >= (64 << VG_TILE_LOG2)) && top + 1 < VG_BIN_DEPTH) {
+				stack[++top] = (p + q) * 0.5;
+				continue;
+			}
+
+			nx = abs(ix1 - ix0);
+			ny = abs(iy1 - iy0);
+			ni = nx + ny;
+
+			sx = x1 >= x0 ? 1 : -1;
+			sy = y1 >= y0 ? 1 : -1;
+			lx = dy > 0 ? (dx << VG_EDGE_LOG2 << VG_TILE_LOG2) / dy * sx : 0;
+			ly = dx > 0 ? (dy << VG_EDGE_LOG2 << VG_TILE_LOG2) / dx * sy : 0;
+			fx = ((sx > 0 ? VG_TILE_MASK - x0 : x0) & VG_TILE_MASK);
+			fy = ((sy > 0 ? VG_TILE_MASK - y0 : y0) & VG_TILE_MASK);
+			tx = (lx * (fy << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
+			ty = (ly * (fx << (VG_EDGE_LOG2 - VG_TILE_LOG2))) >> VG_EDGE_LOG2;
+
+			tx0 = tx1 = x0;
+			ty0 = ty1 = y0;
+			ix1 = ix0;
+			iy1 = iy0;
+
+			ex = -(dy << VG_TILE_LOG2);
+			ey =  (dx << VG_TILE_LOG2);
+			er =  (dx * (fy + 1)) - (dy * (fx + 1));
+
+			while (ni-- >= 0) {
+				tx0 = tx1;
+				ty0 = ty1;
+				ix0 = ix1;
+				iy0 = iy1;
+
+				if (ni == -1) {
+					tx1 = x1;
+					ty1 = y1;
+				} else if (er > 0) {
+					tx1 = ((ix0 + (sx > 0 ? 1 : 0)) << VG_TILE_LOG2);
+					ty1 = y0 + (ty >> VG_EDGE_LOG2);
+
+					er += ex;
+					ty += ly;
+					ix1 += sx;
+
+					if (sx > 0)
+						bin_edge(ix1, iy1, tx1 - 32, (iy1 << VG_TILE_LOG2), tx1 - 32, ty1);
+					else
+						bin_edge(ix0, iy0, tx1 - 32, ty1, tx1 - 32, (iy0 << VG_TILE_LOG2));
+				} else {
+					tx1 = x0 + (tx >> VG_EDGE_LOG2);
+					ty1 = ((iy0 + (sy > 0 ? 1 : 0)) << VG_TILE_LOG2);
+
+					er += ey;
+					tx += lx;
+					iy1 += sy;
+
+					if (sy > 0)
+						bin_sign(ix0, iy0, +1);
+					else
+						bin_sign(ix1, iy1, -1);
+				}
+
+				bin_edge(ix0, iy0, tx0, ty0, tx1, ty1);
+			}
+
+			p = q;
+			top--;
+		}
+	}
+
+	void bin_point(const int item) {
+		int bin, index; uint flags;
+
+		bin = bin_find(item, 2);
+		bin_load(bin);
+		index = di32(get_value(bin + 1)) + (item - di32(get_value(bin + 2))) * 3;
+		flags = du32(get_value(index + 2));
+		if ((flags & uint(VG_BIN_START)) != 0u)
+			return;
+
+		bwinding = (flags & uint(VG_BIN_NEGATIVE)) != 0u ? -1 : 1;
+		bin_segment(
+			vec2(df32(get_value(index - 3)), df32(get_value(index - 2))),
+			vec2(df32(get_value(index + 0)), df32(get_value(index + 1))));
+	}
+
+	void bin_row(const int row) {
+		int bin, y, x, cell, count, sign, size, word, tile, words, tiles;
+
+		bin = bin_find(row, 4);
+		bin_load(bin);
+		y = row - di32(get_value(bin + 4));
+
+		// the first column only carries sign, tiles are one column left of their cell
+		sign  = 0;
+		tiles = upass == VG_BIN_EMIT ? brows[row].x : 0;
+		words = upass == VG_BIN_EMIT ? brows[row].y : 0;
+		for (x = 0; x < bsize.x; x++) {
+			cell = (bcell + x + y * bsize.x) * 4;
+			if (x > 0) {
+				count = bcells[cell];
+				if (sign != 0 || count > 0) {
+					size = (count * 3 + 1) / 2;
+					if (upass == VG_BIN_EMIT) {
+						word = ubase + words;
+						tile = word + size;
+						bcells[cell + 2] = word;
+						bdata[tile + 0] = uint(sign & 0xFFFF) | uint(size << 16);
+						bdata[tile + 1] = uint(bheader);
+						btiles[tiles] = uvec2(uint(bmin.x + x - 1) | uint(bmin.y + y) << 12, uint(usegment + tile));
+					}
+					tiles += 1;
+					words += size + 2;
+				}
+			}
+			sign += bcells[cell + 1];
+		}
+
+		if (upass == VG_BIN_ROWS)
+			brows[row] = ivec2(tiles, words);
+	}
+
+	void bin_scan() {
+		int lid, chunk, first, last, row, i;
+		ivec2 sum, value;
+
+		// every invocation sums a chunk of rows, one scans the chunk totals
+		lid   = int(gl_LocalInvocationIndex);
+		chunk = (uitems + VG_BIN_GROUP - 1) / VG_BIN_GROUP;
+		first = min(lid * chunk, uitems);
+		last  = min(first + chunk, uitems);
+
+		sum = ivec2(0);
+		for (row = first; row < last; row++)
+			sum += brows[row];
+		spartial[lid] = sum;
+		barrier();
+
+		if (lid == 0) {
+			sum = ivec2(0);
+			for (i = 0; i < VG_BIN_GROUP; i++) {
+				value = spartial[i];
+				spartial[i] = sum;
+				sum += value;
+			}
+			bcommand[0] = 4u;
+			bcommand[1] = uint(sum.x);
+			bcommand[2] = 0u;
+			bcommand[3] = 0u;
+		}
+		barrier();
+
+		sum = spartial[lid];
+		for (row = first; row < last; row++) {
+			value = brows[row];
+			brows[row] = sum;
+			sum += value;
+		}
+	}
+
+	void main() {
+		int item = int(gl_GlobalInvocationID.x);
+
+		if (upass == VG_BIN_SCAN) {
+			bin_scan();
+			return;
+		}
+
+		if (item >= uitems)
+			return;
+
+		if (upass == VG_BIN_COUNT || upass == VG_BIN_EDGES)
+			bin_point(item);
+		else
+			bin_row(item);
+	}
+);
+
+// Uploads go through a ring of VGL_RING_SIZE segments, each large enough for a full
+// flush. With GL_ARB_buffer_storage the ring is mapped persistently and the front-end
+// bins straight into it, otherwise it bins into system memory and the segment is
+// mapped unsynchronized and copied at flush. A fence per segment keeps the CPU from
+// overwriting data the GPU has not consumed yet, it is waited on only when binning
+// into the segment starts, so frames pipeline up to VGL_RING_SIZE - 1 deep. The data
+// texture is a texture buffer over the whole ring, tile indices are absolute so no
+// rebinding is needed.
+
+#ifndef VGL_RING_SIZE
+#define VGL_RING_SIZE (3)
+#endif
+
+GLuint    vgl_shader[VG_VARIANT_COUNT];
+GLint     vgl_shader_uscreensize[VG_VARIANT_COUNT];
+GLint     vgl_shader_usegment[VG_VARIANT_COUNT];
+int       vgl_shader_segment[VG_VARIANT_COUNT];
+int       vgl_shader_count;
+int       vgl_shader_bound;
+GLuint    vgl_shader_icoord;
+GLuint    vgl_shader_iedges;
+
+#if VGL_COMPUTE
+GLuint    vgl_compute;
+GLint     vgl_compute_uscreensize;
+GLint     vgl_compute_usegment;
+GLint     vgl_compute_ucount;
+GLuint    vgl_compute_image;
+GLuint    vgl_compute_fbo;
+int       vgl_compute_sizex;
+int       vgl_compute_sizey;
+#endif
+
+#if VGL_GPU_BINNING
+GLuint    vgl_bin;
+GLint     vgl_bin_usegment;
+GLint     vgl_bin_ugrid;
+GLint     vgl_bin_ubins;
+GLint     vgl_bin_uitems;
+GLint     vgl_bin_ubase;
+GLint     vgl_bin_upass;
+GLuint    vgl_bin_cells;
+GLuint    vgl_bin_rows;
+GLuint    vgl_bin_command;
+#endif
+
+GLuint    vgl_buffer_vao;
+GLuint    vgl_buffer_data;
+GLuint    vgl_buffer_draw;
+GLuint    vgl_buffer_text;
+GLuint    vgl_ramp_text;
+GLuint    vgl_image_text;
+
+int       vgl_ring_index;
+int       vgl_ring_mapped;
+GLsync    vgl_ring_fence[VGL_RING_SIZE];
+unsigned *vgl_ring_data;
+vgTile   *vgl_ring_draw;
+
+static void vgl_shader_compile(GLuint program, GLenum type, const GLchar **source, int count)
+{
+	static char log[1024];
+	GLuint shader;
+	GLint result;
+
+	shader = glCreateShader(type);
+	glShaderSource(shader, count, source, 0);
+	glCompileShader(shader);
+	glAttachShader(program, shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &result);
+	if (result == GL_FALSE) {
+		glGetShaderInfoLog(shader, sizeof(log), 0, log);
+		VGL_LOG(log);
+	}
+	glDeleteShader(shader);
+	VGL_TRACE();
+}
+
+static void vgl_program_link(GLuint program)
+{
+	static char log[1024];
+	GLint result;
+
+	glLinkProgram(program);
+	glGetProgramiv(program, GL_LINK_STATUS, &result);
+	if (result == GL_FALSE) {
+		glGetProgramInfoLog(program, sizeof(log), 0, log);
+		VGL_LOG(log);
+	}
+	VGL_TRACE();
+}
+
+static int vgl_has_extension(const char *name)
+{
+	GLint i, count;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (i = 0; i < count; i++) {
+		if (!strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name))
+			return 1;
+	}
+	return 0;
+}
+
+static void vgl_ring_init()
+{
+	GLsizeiptr data, draw;
+	GLint limit;
+
+	data = sizeof(vg_data_storage) * (GLsizeiptr)VGL_RING_SIZE;
+	draw = sizeof(vg_tile_storage) * (GLsizeiptr)VGL_RING_SIZE;
+
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &limit);
+	if (limit / VGL_RING_SIZE < VG_MAX_DATA)
+		VGL_LOG("opengl: data ring exceeds GL_MAX_TEXTURE_BUFFER_SIZE");
+
+	glGenBuffers(1, &vgl_buffer_data);
+	glGenBuffers(1, &vgl_buffer_draw);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+	vgl_ring_mapped = vgl_has_extension("GL_ARB_buffer_storage");
+	if (vgl_ring_mapped) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBindBuffer(GL_TEXTURE_BUFFER, vgl_buffer_data);
+		glBufferStorage(GL_TEXTURE_BUFFER, data, NULL, flags);
+		vgl_ring_data = glMapBufferRange(GL_TEXTURE_BUFFER, 0, data, flags);
+		glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
+		glBufferStorage(GL_ARRAY_BUFFER, draw, NULL, flags);
+		vgl_ring_draw = glMapBufferRange(GL_ARRAY_BUFFER, 0, draw, flags);
+		vgl_ring_mapped = vgl_ring_data && vgl_ring_draw;
+		VGL_TRACE();
+	}
+#endif
+
+	if (!vgl_ring_mapped) {
+		glBindBuffer(GL_TEXTURE_BUFFER, vgl_buffer_data);
+		glBufferData(GL_TEXTURE_BUFFER, data, NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
+		glBufferData(GL_ARRAY_BUFFER, draw, NULL, GL_STREAM_DRAW);
+		VGL_TRACE();
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenTextures(1, &vgl_buffer_text);
+	glBindTexture(GL_TEXTURE_BUFFER, vgl_buffer_text);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8UI, vgl_buffer_data);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	VGL_TRACE();
+}
+
+static void vgl_ring_acquire()
+{
+	GLsync fence;
+	GLenum result;
+
+	fence = vgl_ring_fence[vgl_ring_index];
+	if (fence) {
+		result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		while (result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, 0, 1000000000);
+		glDeleteSync(fence);
+		vgl_ring_fence[vgl_ring_index] = 0;
+	}
+
+	vg_data_base = vgl_ring_index * VG_MAX_DATA;
+	if (vgl_ring_mapped) {
+		vg_data_buffer = vgl_ring_data + vgl_ring_index * VG_MAX_DATA;
+		vg_tile_buffer = vgl_ring_draw + vgl_ring_index * VG_MAX_TILES;
+	} else {
+		vg_data_buffer = vg_data_storage;
+		vg_tile_buffer = vg_tile_storage;
+	}
+}
+
+static void vgl_ring_upload()
+{
+	GLbitfield flags;
+	GLintptr offset;
+	void *dst;
+
+	if (vgl_ring_mapped)
+		return;
+
+	flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+
+	// the entry table and the fill data are separate ranges of the segment
+	offset = (GLintptr)vgl_ring_index * sizeof(vg_data_storage);
+	glBindBuffer(GL_TEXTURE_BUFFER, vgl_buffer_data);
+	dst = glMapBufferRange(GL_TEXTURE_BUFFER, offset, vg_entry_count * VG_ENTRY_SIZE * sizeof(unsigned), flags);
+	if (dst) memcpy(dst, vg_data_buffer, vg_entry_count * VG_ENTRY_SIZE * sizeof(unsigned));
+	glUnmapBuffer(GL_TEXTURE_BUFFER);
+
+	offset += VG_ENTRY_WORDS * sizeof(unsigned);
+	dst = glMapBufferRange(GL_TEXTURE_BUFFER, offset, (vg_data_count - VG_ENTRY_WORDS) * sizeof(unsigned), flags);
+	if (dst) memcpy(dst, vg_data_buffer + VG_ENTRY_WORDS, (vg_data_count - VG_ENTRY_WORDS) * sizeof(unsigned));
+	glUnmapBuffer(GL_TEXTURE_BUFFER);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	offset = (GLintptr)vgl_ring_index * sizeof(vg_tile_storage);
+	dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, vg_tile_count * sizeof(vgTile), flags);
+	if (dst) memcpy(dst, vg_tile_buffer, vg_tile_count * sizeof(vgTile));
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	VGL_TRACE();
+}
+
+#if !VGL_COMPUTE
+static void vgl_ring_bind(int first)
+{
+	const vgTile *base;
+	base = (const vgTile*)0 + vgl_ring_index * VG_MAX_TILES + first;
+	glVertexAttribIPointer(vgl_shader_icoord, 1, GL_UNSIGNED_INT, sizeof(vgTile), &base->coord);
+	glVertexAttribIPointer(vgl_shader_iedges, 1, GL_UNSIGNED_INT, sizeof(vgTile), &base->edges);
+	VGL_TRACE();
+}
+
+static void vgl_shader_bind(int index)
+{
+	if (vgl_shader_bound != index) {
+		vgl_shader_bound = index;
+		glUseProgram(vgl_shader[index]);
+	}
+	if (vgl_shader_segment[index] != vg_data_base) {
+		vgl_shader_segment[index] = vg_data_base;
+		glUniform1i(vgl_shader_usegment[index], vg_data_base);
+	}
+	VGL_TRACE();
+}
+#endif
+
+#if VGL_COMPUTE
+static void vgl_compute_init()
+{
+	const GLchar *source[9];
+
+	vgl_compute = glCreateProgram();
+	source[0] = VGL_VERSION_COMPUTE;
+	source[1] = vgl_shader_variant[VG_VARIANT_COUNT - 1];
+	source[2] = vgl_shader_lib;
+	source[3] = vgl_shader_tile;
+	source[4] = vgl_shader_compute_in;
+	source[5] = vgl_shader_fs;
+	source[6] = VGL_EDGE_SLOPES ? vgl_shader_slope_cover : vgl_shader_cover;
+	source[7] = vgl_shader_list_entry;
+	source[8] = vgl_shader_compute_main;
+	vgl_shader_compile(vgl_compute, GL_COMPUTE_SHADER, source, 9);
+	vgl_program_link(vgl_compute);
+
+	vgl_compute_uscreensize = glGetUniformLocation(vgl_compute, "uscreensize");
+	vgl_compute_usegment    = glGetUniformLocation(vgl_compute, "usegment");
+	vgl_compute_ucount      = glGetUniformLocation(vgl_compute, "ucount");
+	glUseProgram(vgl_compute);
+	glUniform1i(glGetUniformLocation(vgl_compute, "uramps"), 1);
+	glUniform1i(glGetUniformLocation(vgl_compute, "uimages"), 2);
+
+	glGenFramebuffers(1, &vgl_compute_fbo);
+	VGL_TRACE();
+}
+
+static void vgl_compute_prime()
+{
+	if (vgl_compute_sizex != vg.size.x || vgl_compute_sizey != vg.size.y) {
+		vgl_compute_sizex = vg.size.x;
+		vgl_compute_sizey = vg.size.y;
+		glDeleteTextures(1, &vgl_compute_image);
+		glGenTextures(1, &vgl_compute_image);
+		glBindTexture(GL_TEXTURE_2D, vgl_compute_image);
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, vg.size.x, vg.size.y);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, vgl_compute_fbo);
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, vgl_compute_image, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		VGL_TRACE();
+	}
+
+	glUseProgram(vgl_compute);
+	glUniform2i(vgl_compute_uscreensize, vg.size.x, vg.size.y);
+	VGL_TRACE();
+}
+
+static void vgl_compute_flush()
+{
+	GLint framebuffer, limit, groupsx, groupsy;
+
+	// the image takes whatever was drawn or cleared so far and is blitted back
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glBindTexture(GL_TEXTURE_2D, vgl_compute_image);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, vg.size.x, vg.size.y);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	VGL_TRACE();
+
+	glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, 0, &limit);
+	groupsx = vg_tile_count < limit ? vg_tile_count : limit;
+	groupsy = (vg_tile_count + groupsx - 1) / groupsx;
+
+	glUseProgram(vgl_compute);
+	glUniform1i(vgl_compute_usegment, vg_data_base);
+	glUniform1i(vgl_compute_ucount, vg_tile_count);
+	glBindImageTexture(0, vgl_compute_image, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, vgl_buffer_draw,
+		(GLintptr)vgl_ring_index * sizeof(vg_tile_storage), vg_tile_count * sizeof(vgTile));
+	glDispatchCompute(groupsx, groupsy, 1);
+	// the blit reads the image, the next flush copies into it
+	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+	VGL_TRACE();
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, vgl_compute_fbo);
+	glBlitFramebuffer(0, 0, vg.size.x, vg.size.y, 0, 0, vg.size.x, vg.size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	VGL_TRACE();
+}
+#endif
+
+#if VGL_GPU_BINNING
+static void vgl_bin_init()
+{
+	const GLchar *source[4];
+
+	vgl_bin = glCreateProgram();
+	source[0] = VGL_VERSION_COMPUTE;
+	source[1] = vgl_shader_variant[VG_VARIANT_COUNT - 1];
+	source[2] = vgl_shader_lib;
+	source[3] = vgl_shader_bin;
+	vgl_shader_compile(vgl_bin, GL_COMPUTE_SHADER, source, 4);
+	vgl_program_link(vgl_bin);
+
+	vgl_bin_usegment = glGetUniformLocation(vgl_bin, "usegment");
+	vgl_bin_ugrid    = glGetUniformLocation(vgl_bin, "ugrid");
+	vgl_bin_ubins    = glGetUniformLocation(vgl_bin, "ubins");
+	vgl_bin_uitems   = glGetUniformLocation(vgl_bin, "uitems");
+	vgl_bin_ubase    = glGetUniformLocation(vgl_bin, "ubase");
+	vgl_bin_upass    = glGetUniformLocation(vgl_bin, "upass");
+
+	// cells: count, sign, edge base, edge cursor. rows: tiles, words
+	glGenBuffers(1, &vgl_bin_cells);
+	glGenBuffers(1, &vgl_bin_rows);
+	glGenBuffers(1, &vgl_bin_command);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, vgl_bin_cells);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, VG_MAX_CELLS * 4 * sizeof(int), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, vgl_bin_rows);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, VG_MAX_ROWS * 2 * sizeof(int), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, vgl_bin_command);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, 4 * sizeof(unsigned), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	VGL_TRACE();
+}
+
+static void vgl_bin_pass(int pass, int items)
+{
+	glUniform1i(vgl_bin_upass, pass);
+	glUniform1i(vgl_bin_uitems, items);
+	glDispatchCompute(pass == VG_BIN_SCAN ? 1 : (items + VG_BIN_GROUP - 1) / VG_BIN_GROUP, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	VGL_TRACE();
+}
+
+static void vgl_bin_flush()
+{
+	GLintptr data, draw;
+
+	data = (GLintptr)vgl_ring_index * sizeof(vg_data_storage);
+	draw = (GLintptr)vgl_ring_index * sizeof(vg_tile_storage);
+
+	// edges are or-ed into place and cells count from zero
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, vgl_buffer_data);
+	glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, data + vg_data_count * sizeof(unsigned),
+		vg_bin_reserve * sizeof(unsigned), GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, vgl_bin_cells);
+	glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0,
+		vg_bin_cells * 4 * sizeof(int), GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	VGL_TRACE();
+
+	glUseProgram(vgl_bin);
+	glUniform1i(vgl_bin_usegment, vg_data_base);
+	glUniform2i(vgl_bin_ugrid, vg_grid_sizex, vg_grid_sizey);
+	glUniform1i(vgl_bin_ubins, vg_entry_count);
+	glUniform1i(vgl_bin_ubase, vg_data_count);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, vgl_buffer_data, data, sizeof(vg_data_storage));
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, vgl_buffer_draw, draw, sizeof(vg_tile_storage));
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, vgl_bin_cells);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, vgl_bin_rows);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, vgl_bin_command);
+	VGL_TRACE();
+
+	vgl_bin_pass(VG_BIN_COUNT, vg_bin_total);
+	vgl_bin_pass(VG_BIN_ROWS,  vg_bin_rows);
+	vgl_bin_pass(VG_BIN_SCAN,  vg_bin_rows);
+	vgl_bin_pass(VG_BIN_EMIT,  vg_bin_rows);
+	vgl_bin_pass(VG_BIN_EDGES, vg_bin_total);
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	vgl_shader_bound = -1;
+	vgl_shader_bind(0);
+	vgl_ring_bind(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, vgl_bin_command);
+	glDrawArraysIndirect(GL_TRIANGLE_STRIP, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	VGL_TRACE();
+}
+#endif
+
+static void vgl_ring_release()
+{
+	vgl_ring_fence[vgl_ring_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	vgl_ring_index = (vgl_ring_index + 1) % VGL_RING_SIZE;
+}
+
+void vg_driver_init()
+{
+	const GLchar *source[9];
+	GLuint program;
+	int index;
+
+	// without variants a single program takes every fill, compute takes none
+	vgl_shader_count  = VGL_COMPUTE ? 0 : VGL_VARIANTS ? VG_VARIANT_COUNT : 1;
+	vgl_shader_icoord = 0;
+	vgl_shader_iedges = 1;
+
+	for (index = 0; index < vgl_shader_count; index++) {
+		program = glCreateProgram();
+
+		source[0] = VGL_VERSION;
+		source[1] = vgl_shader_variant[VGL_VARIANTS ? index : VG_VARIANT_COUNT - 1];
+		source[2] = vgl_shader_lib;
+		source[3] = VGL_GPU_BINNING ? vgl_shader_bin_tile : vgl_shader_tile;
+		source[4] = VGL_TILE_LISTS ? vgl_shader_list_vs : vgl_shader_vs;
+		vgl_shader_compile(program, GL_VERTEX_SHADER, source, 5);
+
+		source[4] = VGL_TILE_LISTS ? vgl_shader_list_fs_in : vgl_shader_fs_in;
+		source[5] = vgl_shader_fs;
+		source[6] = VGL_EDGE_SLOPES ? vgl_shader_slope_cover : vgl_shader_cover;
+		source[7] = VGL_TILE_LISTS ? vgl_shader_list_entry : "";
+		source[8] = VGL_TILE_LISTS ? vgl_shader_list_fs_main : vgl_shader_fs_main;
+		vgl_shader_compile(program, GL_FRAGMENT_SHADER, source, 9);
+
+		// fixed locations, unused attributes stay valid when a program drops them
+		glBindAttribLocation(program, vgl_shader_icoord, "icoord");
+		glBindAttribLocation(program, vgl_shader_iedges, "iedges");
+		vgl_program_link(program);
+
+		vgl_shader[index] = program;
+		vgl_shader_uscreensize[index] = glGetUniformLocation(program, "uscreensize");
+		vgl_shader_usegment[index]    = glGetUniformLocation(program, "usegment");
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "uramps"), 1);
+		glUniform1i(glGetUniformLocation(program, "uimages"), 2);
+	}
+
+#if VGL_COMPUTE
+	vgl_compute_init();
+#endif
+#if VGL_GPU_BINNING
+	vgl_bin_init();
+#endif
+	vgl_ring_init();
+
+	// gradient ramps, sampled from texture unit 1
+	glGenTextures(1, &vgl_ramp_text);
+	glBindTexture(GL_TEXTURE_2D, vgl_ramp_text);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, VG_RAMP_SIZE, VG_MAX_RAMPS, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	VGL_TRACE();
+
+	glGenVertexArrays(1, &vgl_buffer_vao);
+	glBindVertexArray(vgl_buffer_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
+	glEnableVertexAttribArray(vgl_shader_icoord);
+	glEnableVertexAttribArray(vgl_shader_iedges);
+	glVertexAttribDivisor(vgl_shader_icoord, 1);
+	glVertexAttribDivisor(vgl_shader_iedges, 1);
+	VGL_TRACE();
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+
+	vgl_ring_acquire();
+}
+
+void vg_driver_prime()
+{
+#if !VGL_COMPUTE
+	int index;
+#endif
+
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_STENCIL_TEST);
+	VGL_TRACE();
+
+	glEnable(GL_BLEND);
+	glBlendEquation(GL_FUNC_ADD);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC1_COLOR);
+	glProvokingVertex(GL_LAST_VERTEX_CONVENTION);
+	VGL_TRACE();
+
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, vgl_image_text);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, vgl_ramp_text);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_BUFFER, vgl_buffer_text);
+	glBindBuffer(GL_ARRAY_BUFFER, vgl_buffer_draw);
+	glBindVertexArray(vgl_buffer_vao);
+	VGL_TRACE();
+
+#if VGL_COMPUTE
+	vgl_compute_prime();
+#else
+	for (index = 0; index < vgl_shader_count; index++) {
+		glUseProgram(vgl_shader[index]);
+		glUniform2i(vgl_shader_uscreensize[index], vg.size.x, vg.size.y);
+		vgl_shader_segment[index] = -1;
+	}
+	vgl_shader_bound = vgl_shader_count - 1;
+	VGL_TRACE();
+#endif
+
+	vgl_ring_acquire();
+}
+
+void vg_driver_flush()
+{
+#if !VGL_COMPUTE && !VGL_GPU_BINNING
+	vgDraw *draw;
+	int index;
+#endif
+
+	if (vg_tile_count == 0)
+		return;
+
+	vgl_ring_upload();
+
+#if VGL_COMPUTE
+	vgl_compute_flush();
+#elif VGL_GPU_BINNING
+	vgl_bin_flush();
+#else
+	for (index = 0; index < vg_draw_count; index++) {
+		draw = &vg_draw_buffer[index];
+		vgl_shader_bind(draw->variant);
+		vgl_ring_bind(draw->first);
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, draw->count);
+		VGL_TRACE();
+	}
+#endif
+
+	vgl_ring_release();
+}
+
+void vg_driver_ramp(int index, const unsigned *texels)
+{
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, vgl_ramp_text);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, index, VG_RAMP_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, texels);
+	glActiveTexture(GL_TEXTURE0);
+	VGL_TRACE();
+}
+
+void vg_driver_image(int page, int x, int y, int w, int h, const unsigned *pixels)
+{
+	glActiveTexture(GL_TEXTURE2);
+
+	// image atlas, sampled from texture unit 2, allocated on first use
+	if (!vgl_image_text) {
+		glGenTextures(1, &vgl_image_text);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, vgl_image_text);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, VG_IMAGE_PAGE, VG_IMAGE_PAGE, VG_IMAGE_PAGES, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		VGL_TRACE();
+	}
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, vgl_image_text);
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, page, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	glActiveTexture(GL_TEXTURE0);
+	VGL_TRACE();
+}
+
+void vg_driver_acquire()
+{
+	vgl_ring_acquire();
+}
+
+void vg_driver_submit()
+{
+	// start the GPU on the queued frame while the caller moves on
+	glFlush();
+}
+
+void vg_driver_clear(unsigned color)
+{
+	float r, g, b, a;
+	r = ((color >> 0)  & 0xFF) / 255.0f;
+	g = ((color >> 8)  & 0xFF) / 255.0f;
+	b = ((color >> 16) & 0xFF) / 255.0f;
+	a = ((color >> 24) & 0xFF) / 255.0f;
+	glClearColor(r, g, b, a);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void vg_driver_size(int *w, int *h)
+{
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	*w = viewport[2];
+	*h = viewport[3];
+}
+
+#endif
+
+/*//////////////////////////
+// DRIVER: VULKAN
+//////////////////////////*/
+
+#if VGL_DRIVER == VGL_VULKAN
+// NOT IMPLEMENTED
+#endif
+
+/*//////////////////////////
+// DRIVER: DIRECTX
+//////////////////////////*/
+
+#if VGL_DRIVER == VGL_DIRECTX
+// NOT IMPLEMENTED
+#endif
+
+/*//////////////////////////
+// MATRIX
+//////////////////////////*/
+
+void vg_matrix_identity(float *m)
+{
+	*(vgMatrix*)m = (vgMatrix) { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+}
+
+void vg_matrix_translate(float *m, float x, float y)
+{
+	m[2] += x * m[0] + y * m[1];
+	m[5] += x * m[3] + y * m[4];
+}
+
+void vg_matrix_rotate(float *m, float a)
+{
+	float cs = cosf(a);
+	float sn = sinf(a);
+	float xx = m[0];
+	float xy = m[1];
+	float yx = m[3];
+	float yy = m[4];
+	m[0] = xx *  cs + xy * sn;
+	m[1] = xx * -sn + xy * cs;
+	m[3] = yx *  cs + yy * sn;
+	m[4] = yx * -sn + yy * cs;
+}
+
+void vg_matrix_scale(float *m, float x, float y)
+{
+	m[0] *= x;
+	m[1] *= y;
+	m[3] *= x;
+	m[4] *= y;
+}
+
+void vg_matrix_multiply(float *m, float *a)
+{
+	float xx = m[0];
+	float xy = m[1];
+	float xt = m[2];
+	float yx = m[3];
+	float yy = m[4];
+	float yt = m[5];
+
+	m[0] = xx * a[0] + xy * a[1];
+	m[1] = xx * a[3] + xy * a[4];
+
+	m[3] = yx * a[0] + yy * a[1];
+	m[4] = yx * a[3] + yy * a[4];
+
+	m[2] = xt + a[2];
+	m[5] = yt + a[5];
+}
+
+int vg_matrix_inverse(float *m, float *a)
+{
+	float i, d;
+	d = a[0] * a[4] - a[1] * a[3];
+	if (d > -1e-6f && d < 1e-6f) {
+		vg_matrix_identity(m);
+		return 0;
+	}
+	i = 1.0f / d;
+	m[0] =  a[4] * i;
+	m[1] = -a[1] * i;
+	m[2] = (a[1] * a[5] - a[4] * a[2]) * i;
+	m[3] = -a[3] * i;
+	m[4] =  a[0] * i;
+	m[5] = (a[3] * a[2] - a[0] * a[5]) * i;
+	return 1;
+}
+
+void vg_matrix_lerp(float *m, float *a, float t)
+{
+	m[0] = m[0] * (1.0f - t) + a[0] * t;
+	m[1] = m[1] * (1.0f - t) + a[1] * t;
+	m[2] = m[2] * (1.0f - t) + a[2] * t;
+	m[3] = m[3] * (1.0f - t) + a[3] * t;
+	m[4] = m[4] * (1.0f - t) + a[4] * t;
+	m[5] = m[5] * (1.0f - t) + a[5] * t;
+}
+
+void vg_matrix_project(float *m, float *x, float *y)
+{
+	float sx = *x;
+	float sy = *y;
+	*x = sx * m[0] + sy * m[1] + m[2];
+	*y = sx * m[3] + sy * m[4] + m[5];
+}
+
+void vg_matrix_unproject(float *m, float *x, float *y)
+{
+	vgMatrix inv;
+	vg_matrix_inverse(inv.v, m);
+	vg_matrix_project(inv.v, x, y);
+}
+
+void vg_matrix_projectn(float *m, float *x, float *y)
+{
+	float sx = *x;
+	float sy = *y;
+	*x = sx * m[0] + sy * m[1];
+	*y = sx * m[3] + sy * m[4];
+}
+
+void vg_matrix_unprojectn(float *m, float *x, float *y)
+{
+	vgMatrix inv;
+	vg_matrix_inverse(inv.v, m);
+	vg_matrix_projectn(inv.v, x, y);
+}
+
+void vg_matrix_pan(float *m, float x, float y, float speed)
+{
+	x *= speed; y *= speed;
+	if (x == 0.0f && y == 0.0f) return;
+	vg_matrix_unprojectn(m, &x, &y);
+	vg_matrix_translate(m, x, y);
+}
+
+void vg_matrix_zoom(float *m, float x, float y, float zoom)
+{
+	if (zoom == 0.0f) return;
+	float factor = powf(1.1f, zoom);
+	vg_matrix_unproject(m, &x, &y);
+	vg_matrix_translate(m, x, y);
+	vg_matrix_scale(m, factor, factor);
+	vg_matrix_translate(m, -x, -y);
+}
+
+/*//////////////////////////
+// UNICODE
+//////////////////////////*/
+
+// Copyright (c) 2008-2010 Bjoern Hoehrmann <bjoern@hoehrmann.de>
+// See http://bjoern.hoehrmann.de/utf-8/decoder/dfa/ for details.
+
+#define VG_UTF8_ACCEPT 0
+#define VG_UTF8_REJECT 12
+
+static unsigned vg_decode_utf8(unsigned* state, unsigned* codep, unsigned byte)
+{
+	static const unsigned char utf8d[] = {
+		// The first part of the table maps bytes to character classes that
+		// to reduce the size of the transition table and create bitmasks.
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,  9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+		7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+		8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,  2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+		10,3,3,3,3,3,3,3,3,3,3,3,3,4,3,3, 11,6,6,6,5,8,8,8,8,8,8,8,8,8,8,8,
+
+		// The second part is a transition table that maps a combination
+		// of a state of the automaton and a character class to a state.
+		0,12,24,36,60,96,84,12,12,12,48,72, 12,12,12,12,12,12,12,12,12,12,12,12,
+		12, 0,12,12,12,12,12, 0,12, 0,12,12, 12,24,12,12,12,12,12,24,12,24,12,12,
+		12,12,12,12,12,12,12,24,12,12,12,12, 12,24,12,12,12,12,12,12,12,24,12,12,
+		12,12,12,12,12,12,12,36,12,36,12,12, 12,36,12,12,12,12,12,36,12,36,12,12,
+		12,36,12,12,12,12,12,12,12,12,12,12,
+    };
+
+	unsigned type = utf8d[byte];
+    *codep = (*state != VG_UTF8_ACCEPT) ?
+		(byte & 0x3fu) | (*codep << 6) :
+		(0xff >> type) & (byte);
+
+	*state = utf8d[256 + *state + type];
+	return *state;
+}
+
+/*//////////////////////////
+// TTF FONT
+//////////////////////////*/
+
+// thanks to stb_truetype.h for the reference implementation
+
+typedef struct vgttEntry vgttEntry;
+typedef struct vgttGlyph vgttGlyph;
+typedef struct vgttIter  vgttIter;
+
+struct vgttEntry {
+	unsigned tag;
+	unsigned checksum;
+	unsigned offset;
+	unsigned length;
+};
+
+struct vgttGlyph {
+	int code;
+	int index;
+	int offset;
+	int ncont;
+	int xmin;
+	int ymin;
+	int xmax;
+	int ymax;
+	float width;
+	float lsb;
+	vgttGlyph *next;
+};
+
+struct vgFont {
+	void *data;
+	unsigned size;
+	unsigned version;
+	unsigned num_tables;
+	unsigned search_range;
+	unsigned entry_selector;
+	unsigned range_shift;
+	vgttEntry head;
+	vgttEntry maxp;
+	vgttEntry loca;
+	vgttEntry glyf;
+	vgttEntry cmap;
+	vgttEntry hhea;
+	vgttEntry os_2;
+	vgttEntry hmtx;
+	vgttEntry gpos;
+	vgttEntry kern;
+	vgttEntry cff;
+	vgttGlyph *glyphs[256];
+};
+
+struct vgttIter {
+	vgFont *font;
+	float size;
+	float base_x;
+	float base_y;
+	float curr_x;
+	float curr_y;
+	float next_x;
+	float next_y;
+	unsigned prev_code;
+	unsigned curr_code;
+	vgttGlyph *prev_glyph;
+	vgttGlyph *curr_glyph;
+	const char *str;
+	const char *end;
+};
+
+#ifdef VG_BIG_ENDIAN
+#define TTF_SWAP_U16(V) (V)
+#define TTF_SWAP_U32(V) (V)
+#else
+#define TTF_SWAP_U16(V) (ttf_font_swap_u16(V))
+#define TTF_SWAP_U32(V) (ttf_font_swap_u32(V))
+static unsigned short ttf_font_swap_u16(unsigned short v) { return ((v >> 8) & 0xFF) | (((v) & 0xFF) << 8); }
+static unsigned int   ttf_font_swap_u32(unsigned int   v) { return (((v) >> 24) & 0xFF) | (((v) << 8) & 0xFF0000) | (((v) >> 8) & 0xFF00) | (((v) << 24) & 0xFF000000); }
+#endif
+
+#define TTF_INDEX(TTF, BASE, OFFSET)       ((char*)(TTF)->data + (BASE) + (OFFSET))
+#define TTF_CHECK(TTF, BASE, OFFSET, TYPE) ((BASE)+(OFFSET)+sizeof(TYPE) <= (TTF)->size)
+
+#define TTF_VAL(TTF, BASE, OFFSET, TYPE)   (TTF_CHECK(TTF, BASE, OFFSET, TYPE) ? *(TYPE*)TTF_INDEX(TTF, BASE, OFFSET) : (TYPE)0)
+#define TTF_U8(TTF, BASE, OFFSET)          (TTF_VAL(TTF, BASE, OFFSET, unsigned char))
+#define TTF_U16(TTF, BASE, OFFSET)         (TTF_SWAP_U16(TTF_VAL(TTF, BASE, OFFSET, unsigned short)))
+#define TTF_U32(TTF, BASE, OFFSET)         (TTF_SWAP_U32(TTF_VAL(TTF, BASE, OFFSET, unsigned int)))
+#define TTF_I8(TTF, BASE, OFFSET)          ((signed char)TTF_U8(TTF, BASE, OFFSET))
+#define TTF_I16(TTF, BASE, OFFSET)         ((signed short)TTF_U16(TTF, BASE, OFFSET))
+#define TTF_I32(TTF, BASE, OFFSET)         ((signed int)TTF_U32(TTF, BASE, OFFSET))
+#define TTF_F32(TTF, BASE, OFFSET)         ((TTF_U16(TTF, BASE, OFFSET) / 4.0f) + TTF_U16(TTF, BASE, (OFFSET)+2))
+
+#define TTF_TAG(A,B,C,D) (((D)<<0)|((C)<<8)|((B)<<16)|((A)<<24))
+
+void vg_font_init(vgFont *ttf, void *data, int size)
+{
+	vgttEntry entry;
+	unsigned base, i;
+
+	memset(ttf, 0, sizeof(vgFont));
+	ttf->data = (char*)data;
+	ttf->size = size;
+
+	base = 0;
+	ttf->version        = TTF_U32(ttf, base, 0);
+	ttf->num_tables     = TTF_U16(ttf, base, 4);
+	ttf->search_range   = TTF_U16(ttf, base, 6);
+	ttf->entry_selector = TTF_U16(ttf, base, 8);
+	ttf->range_shift    = TTF_U16(ttf, base, 10);
+
+	base = 12;
+	for (i = 0; i < ttf->num_tables; i++) {
+		entry.tag      = TTF_U32(ttf, base, 0);
+		entry.checksum = TTF_U32(ttf, base, 4);
+		entry.offset   = TTF_U32(ttf, base, 8);
+		entry.length   = TTF_U32(ttf, base, 12);
+
+		switch (entry.tag) {
+		case TTF_TAG('h','e','a','d'): ttf->head = entry; break;
+		case TTF_TAG('m','a','x','p'): ttf->maxp = entry; break;
+		case TTF_TAG('l','o','c','a'): ttf->loca = entry; break;
+		case TTF_TAG('g','l','y','f'): ttf->glyf = entry; break;
+		case TTF_TAG('c','m','a','p'): ttf->cmap = entry; break;
+		case TTF_TAG('h','h','e','a'): ttf->hhea = entry; break;
+		case TTF_TAG('o','s','/','2'): ttf->os_2 = entry; break;
+		case TTF_TAG('h','m','t','x'): ttf->hmtx = entry; break;
+		case TTF_TAG('G','P','O','S'): ttf->gpos = entry; break;
+		case TTF_TAG('k','e','r','n'): ttf->gpos = entry; break;
+		case TTF_TAG('C','F','F',' '): ttf->cff  = entry; break;
+		}
+
+		base += 16;
+	}
+}
+
+vgFont* vg_font_load(const char *filename)
+{
+	int size; void *data;
+	vgFont *font;
+	FILE *file;
+
+	file = fopen(filename, "r");
+	if (!file) return 0;
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	font = malloc(sizeof(vgFont) + size);
+	data = (void*)&font[1];
+
+	fread(data, 1, size, file);
+	fclose(file);
+
+	vg_font_init(font, data, size);
+	return font;
+}
+
+vgFont* vg_font_loadp(void *data, int size)
+{
+	vgFont *font;
+	font = malloc(sizeof(vgFont));
+	vg_font_init(font, data, size);
+	return font;
+}
+
+vgFont* vg_font_default()
+{
+	// TODO: embed small default font?
+	return 0;
+}
+
+static int vg_font_glyph_index(vgFont *ttf, int c)
+{
+	int version, ntables, platformid, encodingid;
+	int oec, osc, odt, oro, ogi, ro, sc, ec, dt;
+	int segcount, range, selector, shift;
+	int base, format, length, offset;
+	int lang, index, i;
+
+	if (c < 0) return 0;
+
+	base = ttf->cmap.offset;
+	version = TTF_U16(ttf, base, 0);
+	ntables = TTF_U16(ttf, base, 2);
+
+	base += 4;
+	platformid = TTF_U16(ttf, base, 0);
+	encodingid = TTF_U16(ttf, base, 2);
+	offset = TTF_U32(ttf, base, 4);
+
+	base = ttf->cmap.offset + offset;
+	format = TTF_U16(ttf, base, 0);
+	length = TTF_U16(ttf, base, 2);
+
+	index = 0;
+
+	if (format == 4) {
+		lang     = TTF_U16(ttf, base, 4);
+ 		segcount = TTF_U16(ttf, base, 6) / 2;
+		range    = TTF_U16(ttf, base, 8);
+		selector = TTF_U16(ttf, base, 10);
+		shift    = TTF_U16(ttf, base, 12);
+
+		oec = base + 14;
+		osc = oec + segcount * 2 + 2;
+		odt = osc + segcount * 2;
+		oro = odt + segcount * 2;
+		ogi = oro + segcount * 2;
+
+		for (i = 0; i < segcount; i++) {
+			sc = TTF_U16(ttf, osc, i * 2);
+			ec = TTF_U16(ttf, oec, i * 2);
+			dt = TTF_I16(ttf, odt, i * 2);
+			if (c <= ec) {
+				if (c >= sc) {
+					ro = TTF_U16(ttf, oro, i * 2);
+					if (ro) {
+						index = TTF_U16(ttf, oro, (i + ro / 2 + (c - sc)) * 2);
+						if (index) index += dt;
+					} else {
+						index = (c + dt) % 65536;
+					}
+				} else {
+					return 0;
+				}
+				break;
+			}
+		}
+	} else
+	if (format == 0) {
+		if (c > 255) return 0;
+		lang = TTF_U8(ttf, base, 4);
+		index = TTF_U8(ttf, base, 6 + c);
+	}
+
+	return index;
+}
+
+static int vg_font_glyph_offset(vgFont *ttf, int index)
+{
+	int offset, wide;
+	wide = TTF_U16(ttf, ttf->head.offset, 50);
+	if (wide)
+		 offset = TTF_U32(ttf, ttf->loca.offset, index * 4);
+	else offset = TTF_U16(ttf, ttf->loca.offset, index * 2) * 2;
+	return ttf->glyf.offset + offset;
+}
+
+static vgttGlyph* vg_font_glyph(vgFont *ttf, int c)
+{
+	int hash, index, offset;
+	vgttGlyph *glyph;
+
+	hash = c & 0xFF;
+	glyph = ttf->glyphs[hash];
+	while (glyph) {
+		if (glyph->code == c)
+			return glyph;
+		glyph = glyph->next;
+	}
+
+	index = vg_font_glyph_index(ttf, c);
+	if (index == 0) return 0;
+
+	offset = vg_font_glyph_offset(ttf, index);
+	if (offset == 0) return 0;
+
+	// TODO: batch alloc
+	glyph = calloc(1, sizeof(vgttGlyph));
+	glyph->code = c;
+	glyph->index = index;
+	glyph->offset = offset;
+	glyph->ncont = TTF_I16(ttf, glyph->offset, 0);
+	glyph->xmin  = TTF_I16(ttf, glyph->offset, 2);
+	glyph->ymin  = TTF_I16(ttf, glyph->offset, 4);
+	glyph->xmax  = TTF_I16(ttf, glyph->offset, 6);
+	glyph->ymax  = TTF_I16(ttf, glyph->offset, 8);
+
+	int nmetrics = TTF_U16(ttf, ttf->hhea.offset, 34);
+	if (glyph->index < nmetrics) {
+		glyph->width = TTF_I16(ttf, ttf->hmtx.offset, 4 * glyph->index) / 2000.0f;
+		glyph->lsb   = TTF_I16(ttf, ttf->hmtx.offset, 4 * glyph->index + 2) / 2000.0f;
+	} else {
+		glyph->width = TTF_I16(ttf, ttf->hmtx.offset, 4 * (nmetrics - 1)) / 2000.0f;
+		glyph->lsb   = TTF_I16(ttf, ttf->hmtx.offset, 4 * nmetrics + 2 * (glyph->index - nmetrics)) / 2000.0f;
+	}
+
+done:
+	glyph->next = ttf->glyphs[hash];
+	ttf->glyphs[hash] = glyph;
+	return glyph;
+}
+
+static int vg_font_glyph_coverage(vgFont *ttf, int ocoverage, int glyph)
+{
+	int format = TTF_U16(ttf, ocoverage, 0);
+	switch (format) {
+	case 1: {
+		int nglyph = TTF_U16(ttf, ocoverage, 2);
+		int l = 0, r = nglyph - 1, m;
+		int straw, needle = glyph;
+		while (l <= r) {
+			m = (l + r) >> 1;
+			straw = TTF_U16(ttf, ocoverage, 4 + 2 * m);
+			if      (needle < straw) r = m - 1;
+			else if (needle > straw) l = m + 1;
+			else     return m;
+		}
+		break; }
+	case 2: {
+		int nrange = TTF_U16(ttf, ocoverage, 2);
+		int orange = ocoverage + 4;
+		int l = 0, r = nrange - 1, m;
+		int orecord, strawa, strawb, needle = glyph;
+		while (l <= r) {
+			m = (l + r) >> 1;
+			orecord = orange + 6 * m;
+			strawa = TTF_U16(ttf, orecord, 0);
+			strawb = TTF_U16(ttf, orecord, 2);
+			if      (needle < strawa) r = m - 1;
+			else if (needle > strawb) l = m + 1;
+			else    return TTF_U16(ttf, orecord, 4) + glyph - strawa;
+		}
+		break; }
+	default:
+		return -1;
+	}
+	return -1;
+}
+
+static float vg_font_glyph_kern_gpos(vgFont *ttf, int g1, int g2)
+{
+	if (!ttf->gpos.tag) return 0;
+
+	int odata = ttf->gpos.offset;
+	if (TTF_U16(ttf, odata, 0) != 1) return 0; // major version 1
+	if (TTF_U16(ttf, odata, 2) != 0) return 0; // minor version 0
+
+	int olist = TTF_U16(ttf, odata, 8) + odata;
+	int nlist = TTF_U16(ttf, olist, 0);
+
+	for (int i = 0; i < nlist; i++) {
+		int olookup = TTF_U16(ttf, olist, 2 + 2 * i) + olist;
+		int tlookup = TTF_U16(ttf, olookup, 0);
+		int nlookup = TTF_U16(ttf, olookup, 4);
+		int ooffset = olookup + 6;
+		if (tlookup != 2) continue; // pair adjustment positioning subtable
+
+		for (int j = 0; j < nlookup; j++) {
+			int otable = TTF_U16(ttf, ooffset, 2 * j) + olookup;
+			int format = TTF_U16(ttf, otable, 0);
+			int ocoverage = TTF_U16(ttf, otable, 2) + otable;
+			int icoverage = vg_font_glyph_coverage(ttf, ocoverage, g1);
+			if (icoverage == -1) continue;
+
+			switch (format) {
+			case 1: {
+				// TODO:
+				return 0; }
+			case 2: {
+				// TODO:
+				return 0; }
+			default:
+				return 0; // unsupported
+			}
+		}
+	}
+
+	return 0;
+}
+
+static float vg_font_glyph_kern_info(vgFont *ttf, int g1, int g2)
+{
+	unsigned needle, straw;
+	int l, r, m;
+
+	if (!ttf->kern.tag) return 0;
+	if (TTF_U16(ttf, ttf->kern.offset, 2) < 1) return 0;
+	if (TTF_U16(ttf, ttf->kern.offset, 8) != 1) return 0;
+
+	l = 0;
+	r = TTF_U16(ttf, ttf->kern.offset, 10) - 1;
+	needle = g1 << 16 | g2;
+
+	while (l <= r) {
+		m = (l + r) >> 1;
+		straw = TTF_U32(ttf, ttf->kern.offset, 18 + (m * 6));
+		if      (needle < straw) r = m - 1;
+		else if (needle > straw) l = m + 1;
+		else return TTF_I16(ttf, ttf->kern.offset, 22 + (m * 6)) / 2000.0f;
+	}
+
+	return 0;
+}
+
+static float vg_font_glyph_kern(vgFont *ttf, int g1, int g2)
+{
+	// TODO: cache?
+	if      (ttf->gpos.tag) return vg_font_glyph_kern_gpos(ttf, g1, g2);
+	else if (ttf->kern.tag) return vg_font_glyph_kern_info(ttf, g1, g2);
+	else                    return 0;
+}
+
+static void vg_font_draw_glyph(vgFont *ttf, float x, float y, float size, int oglyph);
+
+static void vg_font_draw_glyph_contour(vgFont *ttf, float x, float y, float size, int oglyph)
+{
+	int ocont, ncont, npnts, oinst, ninst, oflag, ocoordx, ocoordy, oncurve;
+	int flag, ix, iy, iw, nx, ny, dx, dy, i, c, r;
+	int c0, c1, move, end;
+	vgPoint p0, p1, pc, ps;
+
+	ncont = TTF_I16(ttf, oglyph, 0);
+	if (ncont <= 0) return;
+
+	ocont = oglyph + 10;
+	npnts = TTF_U16(ttf, ocont, (ncont - 1) * 2) + 1;
+	ninst = TTF_U16(ttf, ocont, ncont * 2);
+	oinst = ocont + ncont * 2 + 2;
+	oflag = oinst + ninst;
+	ix = iw = 0;
+
+	// find coord offsets
+	for (i = 0; i < npnts; iw++) {
+		flag = TTF_U8(ttf, oflag, iw);
+
+		if (flag & 0x08 /* REPEAT */) {
+			iw++;
+			r = TTF_U8(ttf, oflag, iw) + 1;
+		} else {
+			r = 1;
+		}
+
+		while (r--) {
+			if (flag & 0x02 /* X_SHORT_VECTOR */) {
+				ix += 1;
+			} else
+			if (!(flag & 0x10 /* X_IS_SAME */)) {
+				ix += 2;
+			}
+			i++;
+		}
+	}
+
+	ocoordx = oflag + iw;
+	ocoordy = ocoordx + ix;
+
+	p0.x = p0.y = ps.x = 0;
+	p1.x = p1.y = ps.y = 0;
+	ix = iy = iw = 0;
+	nx = ny = 0;
+	i = 0;
+
+	// emit contours
+	for (c = i = 0; c < ncont; c++) {
+		c0 = c1 = 0;
+		end = TTF_U16(ttf, ocont, c * 2);
+		move = 1;
+
+		for (; i <= end; iw++) {
+			flag = TTF_U8(ttf, oflag, iw);
+			oncurve = (flag & 0x01);
+
+			if (flag & 0x08 /* REPEAT */) {
+				iw++;
+				r = TTF_U8(ttf, oflag, iw) + 1;
+			} else {
+				r = 1;
+			}
+
+			while (r--) {
+				if (flag & 0x02 /* X_SHORT_VECTOR */) {
+					dx = TTF_U8(ttf, ocoordx, ix);
+					if (!(flag & 0x10 /* X_IS_POSITIVE */))
+							dx = -dx;
+					ix += 1;
+				} else
+				if (flag & 0x10 /* X_IS_SAME */) {
+					dx = 0;
+				} else {
+					dx = TTF_I16(ttf, ocoordx, ix);
+					ix += 2;
+				}
+
+				if (flag & 0x04 /* Y_SHORT_VECTOR */) {
+					dy = TTF_U8(ttf, ocoordy, iy);
+					if (!(flag & 0x20 /* Y_IS_POSITIVE */))
+						dy = -dy;
+					iy += 1;
+				} else
+				if (flag & 0x20 /* Y_IS_SAME */) {
+					dy = 0;
+				} else {
+					dy = TTF_I16(ttf, ocoordy, iy);
+					iy += 2;
+				}
+
+				nx += dx;
+				ny += dy;
+
+				c0 = c1;
+				p0 = p1;
+				p1.x = nx / 2000.0f;
+				p1.y = 1.0f - ny / 2000.0f;
+				p1.x = p1.x * size + x;
+				p1.y = p1.y * size + y;
+				c1 = oncurve == 0;
+
+				if (move) {
+					move = 0;
+					ps = p1;
+					vg_moveto(p1.x, p1.y);
+				} else {
+					if (c1) {
+						if (c0) {
+							pc.x = (p0.x + p1.x) * 0.5f;
+							pc.y = (p0.y + p1.y) * 0.5f;
+							vg_curveto(p0.x, p0.y, pc.x, pc.y);
+						}
+					} else {
+						if (c0) {
+							vg_curveto(p0.x, p0.y, p1.x, p1.y);
+						} else {
+							vg_lineto(p1.x, p1.y);
+						}
+					}
+				}
+				i++;
+			}
+		}
+
+		if (c1) {
+			vg_curveto(p1.x, p1.y, ps.x, ps.y);
+		} else {
+			vg_lineto(ps.x, ps.y);
+		}
+	}
+}
+
+static void vg_font_draw_glyph_compound(vgFont *ttf, float x, float y, float size, int oglyph) {
+	int ncont, ocomp, more, flags, next;
+
+	ncont = TTF_I16(ttf, oglyph, 0);
+	if (ncont >= 0) return;
+
+	ocomp = oglyph + 10;
+// 	flags = TTF_U16(ttf, ocomp, 0);
+// 	next  = TTF_U16(ttf, ocomp, 2);
+// 	more  = 1;
+
+// 	while (more) {
+// 		// TODO: transform
+// 		vg_font_draw_glyph(ttf, x, y, size, vg_font_glyph_offset(ttf, next));
+// 		// TODO: more
+// 		more = 0;
+// 	}
+	do {
+		flags = TTF_U16(ttf, ocomp, 0);
+		next  = TTF_U16(ttf, ocomp, 2);
+// 		if (more)
+			vg_font_draw_glyph(ttf, x, y, size, vg_font_glyph_offset(ttf, next));
+// 		ocomp = next+10;
+		ocomp += 4;
+		if (flags & 0x0001)
+			ocomp += 4;
+		else
+			ocomp += 2;
+	  if (flags & 0x0008)
+	  	ocomp += 2;
+	  else if (flags & 0x0040)
+	  	ocomp += 4;
+	  else if (flags & 0x0080)
+	 	 ocomp += 8;
+		more++;
+	} while (flags & 0x0020);
+}
+
+static void vg_font_draw_glyph(vgFont *ttf, float x, float y, float size, int oglyph) {
+	// TODO: cache?
+	int ncont = TTF_I16(ttf, oglyph, 0);
+	if (ncont < 0) vg_font_draw_glyph_compound(ttf, x, y, size, oglyph);
+	else           vg_font_draw_glyph_contour(ttf, x, y, size, oglyph);
+}
+
+static void vg_font_begin(vgttIter *iter, vgFont *ttf, float x, float y, float size, const char *str, const char *end)
+{
+	iter->font = ttf;
+	iter->size = size;
+	iter->base_x = iter->curr_x = iter->next_x = x;
+	iter->base_y = iter->curr_y = iter->next_y = y;
+	iter->prev_glyph = iter->curr_glyph = 0;
+	iter->prev_code = iter->curr_code = 0;
+	iter->str = str;
+	iter->end = end;
+}
+
+static int vg_font_next(vgttIter *iter)
+{
+	const char *str = iter->str;
+	const char *end = iter->end;
+	unsigned state = 0;
+	unsigned code = 0;
+	vgttGlyph *glyph;
+
+	if (end ? str == end : !str[0])
+		return 0;
+
+	for (; end ? str != end : str[0]; str++) {
+		if (vg_decode_utf8(&state, &code, *(const unsigned char*)str))
+			continue;
+
+		if (code == '\n') {
+			iter->curr_x = iter->next_x = iter->base_x;
+			iter->curr_y = iter->next_y;
+			iter->next_y += iter->size * 0.65f; // TODO: valign
+			iter->prev_code = 0;
+			iter->prev_glyph = 0;
+			continue;
+		}
+
+		// TODO: font fallbacks
+		glyph = vg_font_glyph(iter->font, code);
+
+		if (glyph && iter->prev_glyph)
+			iter->next_x += vg_font_glyph_kern(iter->font, iter->prev_glyph->index, glyph->index);
+
+		iter->curr_x = iter->next_x;
+		iter->curr_y = iter->next_y;
+		iter->prev_code = iter->curr_code;
+		iter->prev_glyph = iter->curr_glyph;
+		iter->curr_code = code;
+		iter->curr_glyph = glyph;
+
+		if (glyph)
+			iter->next_x += glyph->width * iter->size;
+
+		str++;
+		break;
+	}
+
+	iter->str = str;
+	return 1;
+}
+
+void vg_font_draw_char(vgFont *ttf, float x, float y, float size, int c)
+{
+	vgttGlyph *glyph;
+	vg_path();
+	glyph = vg_font_glyph(ttf, c);
+	if (glyph == 0) return;
+	vg_font_draw_glyph(ttf, x, y, size, glyph->offset);
+}
+
+float vg_font_measure_text(vgFont *ttf, float size, const char *str, const char *end)
+{
+	vgttIter iter; float w = 0;
+	vg_font_begin(&iter, ttf, 0, 0, size, str, end);
+	while (vg_font_next(&iter))
+		w = fmaxf(w, iter.next_x);
+	return w;
+}
+
+void vg_font_draw_text(vgFont *ttf, float x, float y, float size, const char *str, const char *end)
+{
+	vgttIter iter;
+	vg_path();
+	vg_font_begin(&iter, ttf, x, y, size, str, end);
+	while (vg_font_next(&iter))
+		if (iter.curr_glyph && iter.curr_code != ' ')
+			vg_font_draw_glyph(ttf, iter.curr_x, iter.curr_y, size, iter.curr_glyph->offset);
+}
+
+/*//////////////////////////
+// COLOR
+//////////////////////////*/
+
+vgColor vg_color_hsv(float h, float s, float v)
+{
+	float r, g, b, f, p, q, t; int i;
+	if (h < 0) h = -h;
+	r = 0.0f, g = 0.0f, b = 0.0f;
+	i = (int)(h * 6);
+	f = h * 6 - i;
+	p = v * (1 - s);
+	q = v * (1 - f * s);
+	t = v * (1 - (1 - f) * s);
+	switch (i % 6) {
+	case 0: r = v, g = t, b = p; break;
+	case 1: r = q, g = v, b = p; break;
+	case 2: r = p, g = v, b = t; break;
+	case 3: r = p, g = q, b = v; break;
+	case 4: r = t, g = p, b = v; break;
+	case 5: r = v, g = p, b = q; break;
+	}
+	return VG_RGBF(r, g, b);
+}
+
+vgColor vg_color_blend(vgColor src, vgColor dst)
+{
+	vgColor a = (src >> 24) + 1;
+	vgColor drb = dst & 0xFF00FF;
+	vgColor dg = dst & 0xFF00;
+	return ((((((src & 0xFF00FF) - drb) * a) >> 8) + drb) & 0xFF00FF) | ((((((src & 0xFF00) - dg) * a) >> 8) + dg) & 0xFF00) | 0xFF000000;
+}
+
+vgColor vg_color_lerp(vgColor src, vgColor dst, vgColor a)
+{
+	return ((((VG_R(src) - VG_R(dst)) * a) >> 8) + VG_R(dst)) << 0  |
+	       ((((VG_G(src) - VG_G(dst)) * a) >> 8) + VG_G(dst)) << 8  |
+	       ((((VG_B(src) - VG_B(dst)) * a) >> 8) + VG_B(dst)) << 16 |
+	       ((((VG_A(src) - VG_A(dst)) * a) >> 8) + VG_A(dst)) << 24;
+}
+
+vgColor vg_color_lerpf(vgColor src, vgColor dst, float a)
+{
+	return vg_color_lerp(src, dst, (vgColor)(a * 255));
+}
+
+/*//////////////////////////
+// COMMANDS
+//////////////////////////*/
+
+void vg_eval(vgCommand *cmd) {
+	while (1) {
+		switch (cmd->type) {
+		case VG_CMD_MOVETO:
+			vg_moveto(cmd->moveto.coords[0], cmd->moveto.coords[1]);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->moveto));
+			break;
+		case VG_CMD_LINETO:
+			vg_lineto(cmd->lineto.coords[0], cmd->lineto.coords[1]);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->lineto));
+			break;
+		case VG_CMD_CURVETO:
+			vg_curveto(cmd->curveto.coords[0], cmd->curveto.coords[1], cmd->curveto.coords[2], cmd->curveto.coords[3]);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->curveto));
+			break;
+		case VG_CMD_CUBICTO:
+			vg_cubicto(cmd->cubicto.coords[0], cmd->cubicto.coords[1], cmd->cubicto.coords[2], cmd->cubicto.coords[3], cmd->cubicto.coords[4], cmd->cubicto.coords[5]);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->cubicto));
+			break;
+		case VG_CMD_ALPHA:
+			vg_alpha(cmd->alpha.value);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->alpha));
+			break;
+		case VG_CMD_FILL:
+			vg_fill(cmd->fill.color);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->fill));
+			break;
+		case VG_CMD_STROKE:
+			vg_stroke(cmd->stroke.color, cmd->stroke.width);
+			cmd = (vgCommand*)((char*)cmd + sizeof(cmd->stroke));
+			break;
+		default: return;
+		}
+	}
+}
+
+#endif
+#endif